@@ -0,0 +1,117 @@
+#include "deque.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <utility>
+
+// 环形缓冲区的下标换算：取模（改动之前的写法）和按位与（容量为 2 的幂）对比
+
+namespace {
+
+constexpr std::size_t kOps = 50'000'000;
+constexpr std::size_t kQueueLen = 1000;
+constexpr std::size_t kAccessLen = 1 << 16;
+
+// 改动前的 deque：容量不限制，下标用 % 换算
+template <typename T> class modulo_ring {
+public:
+  void push_back(const T &value) {
+    if (size_ == capacity_) {
+      reallocate(capacity_ == 0 ? 1 : 2 * capacity_);
+    }
+    data_[(front_ + size_) % capacity_] = value;
+    ++size_;
+  }
+  void pop_front() {
+    front_ = (front_ + 1) % capacity_;
+    --size_;
+  }
+  T &operator[](std::size_t pos) { return data_[(front_ + pos) % capacity_]; }
+  std::size_t size() const { return size_; }
+
+private:
+  std::unique_ptr<T[]> data_;
+  std::size_t capacity_ = 0;
+  std::size_t size_ = 0;
+  std::size_t front_ = 0;
+
+  void reallocate(std::size_t new_capacity) {
+    auto new_data = std::make_unique<T[]>(new_capacity);
+    for (std::size_t i = 0; i < size_; ++i) {
+      new_data[i] = std::move((*this)[i]);
+    }
+    data_ = std::move(new_data);
+    capacity_ = new_capacity;
+    front_ = 0;
+  }
+};
+
+template <typename F> double ns_per_op(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         kOps;
+}
+
+// 队列长度固定，反复从尾部进、头部出
+template <typename Queue> double bench_fifo() {
+  Queue q;
+  for (std::size_t i = 0; i < kQueueLen; ++i) {
+    q.push_back(i);
+  }
+  volatile std::uint64_t sink = 0;
+  double ns = ns_per_op([&] {
+    for (std::size_t i = 0; i < kOps; ++i) {
+      q.push_back(i);
+      q.pop_front();
+    }
+    sink = q[0];
+  });
+  return ns;
+}
+
+// 伪随机下标读取；front 不在 0，换算时真的要绕回
+template <typename Queue> double bench_random_access() {
+  Queue q;
+  for (std::size_t i = 0; i < kAccessLen + kAccessLen / 2; ++i) {
+    q.push_back(i);
+  }
+  for (std::size_t i = 0; i < kAccessLen / 2; ++i) {
+    q.pop_front();
+    q.push_back(i);
+  }
+  volatile std::uint64_t sink = 0;
+  double ns = ns_per_op([&] {
+    std::uint64_t sum = 0;
+    std::size_t pos = 1;
+    for (std::size_t i = 0; i < kOps; ++i) {
+      pos = (pos * 1103515245 + 12345) & (kAccessLen - 1);
+      sum += q[pos];
+    }
+    sink = sum;
+  });
+  return ns;
+}
+
+} // namespace
+
+int main() {
+  using u64 = std::uint64_t;
+  std::printf("%zu ops, queue length %zu, random access over %zu elements\n",
+              kOps, kQueueLen, kAccessLen);
+
+  double fifo_mod = bench_fifo<modulo_ring<u64>>();
+  double fifo_mask = bench_fifo<my_stl::deque<u64>>();
+  std::printf("push_back+pop_front  modulo %6.2f ns  mask %6.2f ns (%.1fx)\n",
+              fifo_mod, fifo_mask, fifo_mod / fifo_mask);
+
+  double rand_mod = bench_random_access<modulo_ring<u64>>();
+  double rand_mask = bench_random_access<my_stl::deque<u64>>();
+  std::printf("operator[] random    modulo %6.2f ns  mask %6.2f ns (%.1fx)\n",
+              rand_mod, rand_mask, rand_mod / rand_mask);
+  return 0;
+}
@@ -1,13 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#include "growth_policy.hpp"
+#include "snapshot.hpp"
+#include "vector/simd_algorithms.hpp"
+
 namespace my_stl {
 
-template <typename T> class deque {
+// 容量总是 2 的幂，下标换算只需一次按位与而不是取模。
+// 所以 Growth 只能是 grow_2x：其他策略（grow_1_5x、grow_fixed 等）的结果
+// 都会被取整成翻倍，起不到省内存的作用，干脆在编译期拒绝。
+// 内存紧张时请用 block_deque，它按固定大小的块增长
+template <typename T, typename Growth = grow_2x> class deque {
+  static_assert(std::is_same_v<Growth, grow_2x>,
+                "deque capacity is a power of two; only grow_2x applies");
+
 public:
   using value_type = T;
   using reference = T &;
@@ -20,19 +41,19 @@ public:
   deque() = default;
   // 数量构造
   explicit deque(size_type count)
-      : data_(count == 0 ? nullptr : std::make_unique<T[]>(count)),
-        capacity_(count), size_(count), front_(0) {}
+      : data_(allocate(ring_capacity(count))), capacity_(ring_capacity(count)),
+        size_(count), front_(0) {}
   deque(size_type count, const T &value)
-      : data_(count == 0 ? nullptr : std::make_unique<T[]>(count)),
-        capacity_(count), size_(count), front_(0) {
+      : data_(allocate(ring_capacity(count))), capacity_(ring_capacity(count)),
+        size_(count), front_(0) {
     for (size_type i = 0; i < size_; ++i) {
       data_[i] = value;
     }
   }
   // 初始化列表
   deque(std::initializer_list<T> init)
-      : data_(init.size() == 0 ? nullptr : std::make_unique<T[]>(init.size())),
-        capacity_(init.size()), size_(init.size()), front_(0) {
+      : data_(allocate(ring_capacity(init.size()))),
+        capacity_(ring_capacity(init.size())), size_(init.size()), front_(0) {
     size_type i = 0;
     for (const auto &value : init) {
       data_[i++] = value;
@@ -43,9 +64,8 @@ public:
 
   // 拷贝构造函数
   deque(const deque &other)
-      : data_(other.capacity_ == 0 ? nullptr
-                                   : std::make_unique<T[]>(other.capacity_)),
-        capacity_(other.capacity_), size_(other.size_), front_(0) {
+      : data_(allocate(other.capacity_)), capacity_(other.capacity_),
+        size_(other.size_), front_(0) {
     for (size_type i = 0; i < size_; ++i) {
       data_[i] = other[i];
     }
@@ -296,6 +316,18 @@ public:
 
   bool empty() const noexcept { return size_ == 0; }
   size_type size() const noexcept { return size_; }
+  // 环形缓冲区的大小，总是 0 或 2 的幂
+  size_type capacity() const noexcept { return capacity_; }
+
+  // 按逻辑顺序排列的两段连续存储；没有绕回时第二段为空
+  std::pair<std::span<T>, std::span<T>> as_spans() noexcept {
+    size_type first = std::min(size_, capacity_ - front_);
+    return {{data_.get() + front_, first}, {data_.get(), size_ - first}};
+  }
+  std::pair<std::span<const T>, std::span<const T>> as_spans() const noexcept {
+    size_type first = std::min(size_, capacity_ - front_);
+    return {{data_.get() + front_, first}, {data_.get(), size_ - first}};
+  }
 
   void clear() noexcept {
     size_ = 0;
@@ -304,7 +336,7 @@ public:
 
   void push_back(const T &value) {
     if (size_ == capacity_) {
-      reallocate(capacity_ == 0 ? 1 : capacity_ * 2);
+      grow();
     }
 
     data_[physical_index(size_)] = value;
@@ -312,7 +344,7 @@ public:
   }
   void push_back(T &&value) {
     if (size_ == capacity_) {
-      reallocate(capacity_ == 0 ? 1 : capacity_ * 2);
+      grow();
     }
 
     data_[physical_index(size_)] = std::move(value);
@@ -320,19 +352,19 @@ public:
   }
   void push_front(const T &value) {
     if (size_ == capacity_) {
-      reallocate(capacity_ == 0 ? 1 : capacity_ * 2);
+      grow();
     }
 
-    front_ = (front_ + capacity_ - 1) % capacity_;
+    front_ = (front_ - 1) & (capacity_ - 1);
     data_[front_] = value;
     ++size_;
   }
   void push_front(T &&value) {
     if (size_ == capacity_) {
-      reallocate(capacity_ == 0 ? 1 : capacity_ * 2);
+      grow();
     }
 
-    front_ = (front_ + capacity_ - 1) % capacity_;
+    front_ = (front_ - 1) & (capacity_ - 1);
     data_[front_] = std::move(value);
     ++size_;
   }
@@ -353,7 +385,7 @@ public:
       throw std::out_of_range("deque::pop_front on empty deque");
     }
 
-    front_ = (front_ + 1) % capacity_;
+    front_ = (front_ + 1) & (capacity_ - 1);
     --size_;
 
     if (size_ == 0) {
@@ -361,45 +393,97 @@ public:
     }
   }
 
-  iterator insert(const_iterator pos, const T &value) {
-    size_type index = pos.index_;
+  // ===== 批量读写：把 deque 当作字节环形缓冲区用 =====
+  // 每个操作最多拷贝两段连续区域，T 可平凡复制时用 memcpy
+
+  // 把 [src, src + n) 追加到末尾；src 不能指向本 deque 内部
+  void append(const T *src, size_type n) {
+    reserve_back(n);
+    auto [head, tail] = free_spans();
+    size_type first = std::min(n, head.size());
+    copy_elements(src, first, head.data());
+    copy_elements(src + first, n - first, tail.data());
+    size_ += n;
+  }
 
-    if (index > size_) {
-      throw std::out_of_range("deque::insert position out of range");
+  // 丢掉开头的 n 个元素
+  void consume(size_type n) {
+    if (n > size_) {
+      throw std::out_of_range("deque::consume more than size");
     }
 
-    if (size_ == capacity_) {
-      reallocate(capacity_ == 0 ? 1 : capacity_ * 2);
-    }
+    front_ = physical_index(n);
+    size_ -= n;
 
-    for (size_type i = size_; i > index; --i) {
-      (*this)[i] = std::move((*this)[i - 1]);
+    if (size_ == 0) {
+      front_ = 0;
     }
+  }
 
-    (*this)[index] = value;
-    ++size_;
-
-    return iterator(this, index);
+  // 把开头至多 n 个元素拷贝到 dst，不删除，返回拷贝的个数
+  size_type peek(T *dst, size_type n) const {
+    n = std::min(n, size_);
+    auto [head, tail] = as_spans();
+    size_type first = std::min(n, head.size());
+    copy_elements(head.data(), first, dst);
+    copy_elements(tail.data(), n - first, dst + first);
+    return n;
   }
-  iterator insert(const_iterator pos, T &&value) {
-    size_type index = pos.index_;
 
-    if (index > size_) {
-      throw std::out_of_range("deque::insert position out of range");
-    }
+  // peek 之后再 consume，返回取出的个数
+  size_type drain_into(T *dst, size_type n) {
+    n = peek(dst, n);
+    consume(n);
+    return n;
+  }
 
-    if (size_ == capacity_) {
-      reallocate(capacity_ == 0 ? 1 : capacity_ * 2);
+  // 末尾之后的空闲位置，至少 min_free 个（不够就先扩容），按顺序分成两段。
+  // 可以直接交给 readv/recv 填写，写完用 commit(n) 把前 n 个算进 deque；
+  // 之间任何其他修改都会使这两段失效
+  std::pair<std::span<T>, std::span<T>> writable_spans(size_type min_free = 0) {
+    reserve_back(min_free);
+    return free_spans();
+  }
+  void commit(size_type n) {
+    if (n > capacity_ - size_) {
+      throw std::out_of_range("deque::commit more than free space");
     }
+    size_ += n;
+  }
 
-    for (size_type i = size_; i > index; --i) {
-      (*this)[i] = std::move((*this)[i - 1]);
+  // 插入和删除都只移动离 pos 较近的那一端
+  iterator insert(const_iterator pos, const T &value) {
+    T tmp(value); // value 可能引用本队列内的元素
+    return insert_n(pos.index_, std::make_move_iterator(&tmp), 1);
+  }
+  iterator insert(const_iterator pos, T &&value) {
+    T tmp(std::move(value));
+    return insert_n(pos.index_, std::make_move_iterator(&tmp), 1);
+  }
+  // 在 pos 处插入 count 个 value
+  iterator insert(const_iterator pos, size_type count, const T &value) {
+    T tmp(value);
+    return insert_n(pos.index_, repeat_iterator{&tmp}, count);
+  }
+  // 在 pos 处插入 [first, last)，最多扩容一次，元素只移动一次；
+  // 区间不能引用本队列内的元素
+  template <std::input_iterator InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>) {
+      return insert_n(pos.index_, first,
+                      static_cast<size_type>(std::distance(first, last)));
+    } else {
+      // 单遍迭代器拿不到长度，先收集起来再整体插入
+      deque tmp;
+      for (; first != last; ++first) {
+        tmp.push_back(*first);
+      }
+      return insert_n(pos.index_, std::make_move_iterator(tmp.begin()),
+                      tmp.size());
     }
-
-    (*this)[index] = std::move(value);
-    ++size_;
-
-    return iterator(this, index);
+  }
+  iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
+    return insert(pos, ilist.begin(), ilist.end());
   }
 
   iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
@@ -417,8 +501,12 @@ public:
       return begin() + static_cast<difference_type>(first_index);
     }
 
-    for (size_type i = first_index; i + count < size_; ++i) {
-      (*this)[i] = std::move((*this)[i + count]);
+    if (first_index < size_ - last_index) {
+      // 前面的元素少：整体后移 count 位，front_ 跟着后移
+      move_range(0, count, first_index);
+      front_ = (front_ + count) & (capacity_ - 1);
+    } else {
+      move_range(last_index, first_index, size_ - last_index);
     }
 
     size_ -= count;
@@ -441,6 +529,30 @@ public:
     }
   }
 
+  // 二进制快照（格式见 snapshot.hpp）：环形缓冲区的两段按逻辑顺序写出
+  void save(std::ostream &out) const
+    requires snapshottable<T>
+  {
+    save_snapshot_to(out);
+  }
+  void save(int fd) const
+    requires snapshottable<T>
+  {
+    save_snapshot_to(fd);
+  }
+
+  // 从快照恢复到一块刚好放得下的连续存储；出错时抛异常，原有内容不变
+  void load(std::istream &in)
+    requires snapshottable<T>
+  {
+    load_snapshot_from(in);
+  }
+  void load(int fd)
+    requires snapshottable<T>
+  {
+    load_snapshot_from(fd);
+  }
+
   void swap(deque &other) noexcept {
     std::swap(data_, other.data_);
     std::swap(capacity_, other.capacity_);
@@ -454,19 +566,848 @@ private:
   size_type size_{0};
   size_type front_{0};
 
+  template <typename Sink> void save_snapshot_to(Sink &sink) const {
+    auto [head, tail] = as_spans();
+    detail::save_snapshot<T>(sink, head.data(), head.size(), tail.data(),
+                             tail.size());
+  }
+
+  template <typename Source> void load_snapshot_from(Source &source) {
+    deque tmp;
+    detail::load_snapshot<T>(source, [&tmp](size_type count) {
+      tmp.capacity_ = ring_capacity(count);
+      if (count != 0) {
+        tmp.data_ = std::make_unique_for_overwrite<T[]>(tmp.capacity_);
+      }
+      tmp.size_ = count;
+      return tmp.data_.get();
+    });
+    swap(tmp);
+  }
+
+  // 同一个值重复 n 次的只读"迭代器"，让 count/value 版本复用区间逻辑
+  struct repeat_iterator {
+    const T *value;
+
+    const T &operator*() const noexcept { return *value; }
+    repeat_iterator &operator++() noexcept { return *this; }
+  };
+
+  // 在 index 处放入从 first 开始的 n 个元素。
+  // 需要扩容时在新缓冲区里直接留出空位，每个旧元素只搬一次；
+  // 否则把 index 前后较短的那一段向外移动 n 位
+  template <typename It>
+  iterator insert_n(size_type index, It first, size_type n) {
+    if (index > size_) {
+      throw std::out_of_range("deque::insert position out of range");
+    }
+
+    if (n > capacity_ - size_) {
+      size_type new_capacity =
+          ring_capacity(Growth::next_capacity(capacity_, size_ + n));
+      auto new_data = allocate(new_capacity);
+      for (size_type i = 0; i < index; ++i) {
+        new_data[i] = std::move((*this)[i]);
+      }
+      for (size_type i = 0; i < n; ++i, ++first) {
+        new_data[index + i] = *first;
+      }
+      for (size_type i = index; i < size_; ++i) {
+        new_data[i + n] = std::move((*this)[i]);
+      }
+      data_ = std::move(new_data);
+      capacity_ = new_capacity;
+      front_ = 0;
+      size_ += n;
+      return iterator(this, index);
+    }
+
+    if (index < size_ - index) {
+      // 前面的元素少：front_ 前移 n 位，前半段整体前移
+      front_ = (front_ - n) & (capacity_ - 1);
+      size_ += n;
+      move_range(n, 0, index);
+    } else {
+      move_range(index, index + n, size_ - index);
+      size_ += n;
+    }
+    for (size_type i = 0; i < n; ++i, ++first) {
+      (*this)[index + i] = *first;
+    }
+    return iterator(this, index);
+  }
+
+  // 把逻辑位置 [from, from + count) 的元素移到 [to, to + count)，允许重叠。
+  // 按物理上连续的分段调用 std::move / std::move_backward，
+  // 平凡类型会变成 memmove
+  void move_range(size_type from, size_type to, size_type count) {
+    T *base = data_.get();
+    if (to < from) {
+      while (count > 0) {
+        size_type src = physical_index(from);
+        size_type dst = physical_index(to);
+        size_type chunk =
+            std::min({count, capacity_ - src, capacity_ - dst});
+        std::move(base + src, base + src + chunk, base + dst);
+        from += chunk;
+        to += chunk;
+        count -= chunk;
+      }
+    } else if (to > from) {
+      while (count > 0) {
+        size_type src_end = physical_index(from + count - 1) + 1;
+        size_type dst_end = physical_index(to + count - 1) + 1;
+        size_type chunk = std::min({count, src_end, dst_end});
+        std::move_backward(base + src_end - chunk, base + src_end,
+                           base + dst_end);
+        count -= chunk;
+      }
+    }
+  }
+
+  // 能放下 count 个元素的最小 2 的幂，0 个元素不分配
+  static size_type ring_capacity(size_type count) {
+    if (count == 0) {
+      return 0;
+    }
+    if (count > std::numeric_limits<size_type>::max() / 2 + 1) {
+      throw std::length_error("deque capacity overflow");
+    }
+    return std::bit_ceil(count);
+  }
+  static std::unique_ptr<T[]> allocate(size_type capacity) {
+    return capacity == 0 ? nullptr : std::make_unique<T[]>(capacity);
+  }
+
+  // 保证末尾之后至少还有 n 个空位
+  void reserve_back(size_type n) {
+    if (n > capacity_ - size_) {
+      reallocate(ring_capacity(Growth::next_capacity(capacity_, size_ + n)));
+    }
+  }
+  std::pair<std::span<T>, std::span<T>> free_spans() noexcept {
+    size_type back = physical_index(size_);
+    size_type free = capacity_ - size_;
+    size_type first = std::min(free, capacity_ - back);
+    return {{data_.get() + back, first}, {data_.get(), free - first}};
+  }
+  static void copy_elements(const T *src, size_type n, T *dst) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (n != 0) {
+        std::memcpy(dst, src, n * sizeof(T));
+      }
+    } else {
+      std::copy_n(src, n, dst);
+    }
+  }
+
+  // 容量是 2 的幂，取模退化成按位与
   size_type physical_index(size_type logical_index) const noexcept {
-    return (front_ + logical_index) % capacity_;
+    return (front_ + logical_index) & (capacity_ - 1);
+  }
+  void grow() {
+    reallocate(ring_capacity(Growth::next_capacity(capacity_, size_ + 1)));
   }
   void reallocate(size_type new_capacity) {
-    auto new_data = std::make_unique<T[]>(new_capacity);
+    auto new_data = allocate(new_capacity);
 
-    for (size_type i = 0; i < size_; ++i) {
-      new_data[i] = std::move((*this)[i]);
-    }
+    auto [head, tail] = as_spans();
+    T *out = std::move(head.begin(), head.end(), new_data.get());
+    std::move(tail.begin(), tail.end(), out);
 
     data_ = std::move(new_data);
     capacity_ = new_capacity;
     front_ = 0;
   }
 };
+
+// ===== deque 的按段算法 =====
+// 在 as_spans() 的两段上各跑一遍指针版本的循环，编译器可以向量化；
+// find 对 int32/float/double 改用 simd::find
+
+template <typename T, typename Growth, typename OutputIt>
+OutputIt copy(const deque<T, Growth> &d, OutputIt out) {
+  auto [head, tail] = d.as_spans();
+  out = std::copy(head.begin(), head.end(), out);
+  return std::copy(tail.begin(), tail.end(), out);
+}
+
+template <typename T, typename Growth>
+void fill(deque<T, Growth> &d, const T &value) {
+  auto [head, tail] = d.as_spans();
+  std::fill(head.begin(), head.end(), value);
+  std::fill(tail.begin(), tail.end(), value);
+}
+
+template <typename T, typename Growth, typename F>
+F for_each(deque<T, Growth> &d, F f) {
+  auto [head, tail] = d.as_spans();
+  for (T &x : head) {
+    f(x);
+  }
+  for (T &x : tail) {
+    f(x);
+  }
+  return f;
+}
+template <typename T, typename Growth, typename F>
+F for_each(const deque<T, Growth> &d, F f) {
+  auto [head, tail] = d.as_spans();
+  for (const T &x : head) {
+    f(x);
+  }
+  for (const T &x : tail) {
+    f(x);
+  }
+  return f;
+}
+
+template <typename T, typename Growth, typename U,
+          typename BinaryOp = std::plus<>>
+U accumulate(const deque<T, Growth> &d, U init, BinaryOp op = {}) {
+  auto [head, tail] = d.as_spans();
+  init = std::accumulate(head.begin(), head.end(), std::move(init), op);
+  return std::accumulate(tail.begin(), tail.end(), std::move(init), op);
+}
+
+namespace detail {
+// 在一段里找 value，返回段内下标，找不到返回段长
+template <typename T>
+std::size_t find_in_span(std::span<const T> seg, const T &value) {
+  const T *hit;
+  if constexpr (simd::kernel_type<T>) {
+    hit = simd::find(seg.data(), seg.data() + seg.size(), value);
+  } else {
+    hit = std::find(seg.data(), seg.data() + seg.size(), value);
+  }
+  return static_cast<std::size_t>(hit - seg.data());
+}
+} // namespace detail
+
+template <typename T, typename Growth>
+typename deque<T, Growth>::const_iterator find(const deque<T, Growth> &d,
+                                               const T &value) {
+  auto [head, tail] = d.as_spans();
+  std::size_t pos = detail::find_in_span(head, value);
+  if (pos == head.size()) {
+    pos += detail::find_in_span(tail, value);
+  }
+  return d.begin() + static_cast<std::ptrdiff_t>(pos);
+}
+template <typename T, typename Growth>
+typename deque<T, Growth>::iterator find(deque<T, Growth> &d, const T &value) {
+  auto pos = find(std::as_const(d), value) - d.cbegin();
+  return d.begin() + pos;
+}
+
+// 分块存储的双端队列，接口与 deque 相同，布局和 std::deque 一样：
+// 元素放在固定大小的块里，map_ 是指向各块的指针数组。
+// push_front / push_back 从不移动已有元素，扩容时只重新分配（或居中平移）
+// map_ 这个指针数组，所以两端增删不会使其他元素的引用失效，
+// 单次 push 的最坏耗时也只和块数有关，不再有 O(n) 的整体搬移。
+// 代价是下标访问多一次间接寻址；insert / erase 仍会使引用失效。
+// BlockBytes：每块的目标字节数，块内元素个数取 2 的幂（至少 16 个）。
+template <typename T, std::size_t BlockBytes = 4096> class block_deque {
+public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // 每块的元素个数
+  static constexpr size_type block_size =
+      std::bit_floor(std::max<size_type>(BlockBytes / sizeof(T), 16));
+
+  block_deque() = default;
+  // 数量构造
+  explicit block_deque(size_type count) : block_deque() { resize(count); }
+  block_deque(size_type count, const T &value) : block_deque() {
+    resize(count, value);
+  }
+  // 初始化列表
+  block_deque(std::initializer_list<T> init) : block_deque() {
+    for (const auto &value : init) {
+      push_back(value);
+    }
+  }
+
+  ~block_deque() { clear(); }
+
+  // 拷贝构造函数
+  block_deque(const block_deque &other) : block_deque() {
+    for (size_type i = 0; i < other.size_; ++i) {
+      push_back(other[i]);
+    }
+  }
+
+  // Move constructor
+  block_deque(block_deque &&other) noexcept
+      : map_(std::exchange(other.map_, std::unique_ptr<T *[]>{})),
+        map_size_(std::exchange(other.map_size_, 0)),
+        start_(std::exchange(other.start_, 0)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  // 拷贝赋值操作符
+  block_deque &operator=(const block_deque &other) {
+    if (this == &other)
+      return *this;
+
+    block_deque tmp(other); // 复用拷贝构造
+    swap(tmp);              // 交换资源
+    return *this;
+  }
+
+  // Move assignment
+  block_deque &operator=(block_deque &&other) noexcept {
+    if (this == &other)
+      return *this;
+
+    block_deque tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+
+  block_deque &operator=(std::initializer_list<T> init) {
+    block_deque tmp(init);
+    swap(tmp);
+    return *this;
+  }
+
+  // 按下标记录位置的迭代器，两端 push 之后仍然有效
+  template <typename Owner, typename Ref> class index_iterator {
+    friend class block_deque;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::remove_reference_t<Ref> *;
+    using reference = Ref;
+
+    index_iterator() noexcept : owner_(nullptr), index_(0) {}
+    // iterator 可以转换成 const_iterator
+    template <typename O, typename R>
+      requires std::is_convertible_v<O *, Owner *>
+    index_iterator(const index_iterator<O, R> &other) noexcept
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    pointer operator->() const { return std::addressof((*owner_)[index_]); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    index_iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    index_iterator operator++(int) {
+      index_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    index_iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    index_iterator operator--(int) {
+      index_iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    index_iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    index_iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    index_iterator operator+(difference_type n) const {
+      return index_iterator(owner_, index_ + n);
+    }
+    index_iterator operator-(difference_type n) const {
+      return index_iterator(owner_, index_ - n);
+    }
+    difference_type operator-(const index_iterator &rhs) const {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(rhs.index_);
+    }
+    friend index_iterator operator+(difference_type n,
+                                    const index_iterator &it) {
+      return it + n;
+    }
+
+    auto operator<=>(const index_iterator &) const = default;
+
+  private:
+    template <typename, typename> friend class index_iterator;
+
+    Owner *owner_;
+    size_type index_;
+
+    index_iterator(Owner *owner, size_type index)
+        : owner_(owner), index_(index) {}
+  };
+
+  using iterator = index_iterator<block_deque, T &>;
+  using const_iterator = index_iterator<const block_deque, const T &>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  reference operator[](size_type pos) { return *slot(start_ + pos); }
+  const_reference operator[](size_type pos) const {
+    return *slot(start_ + pos);
+  }
+
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("block_deque::at out of range");
+    }
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("block_deque::at out of range");
+    }
+    return (*this)[pos];
+  }
+
+  reference front() {
+    if (empty()) {
+      throw std::out_of_range("block_deque::front on empty deque");
+    }
+    return (*this)[0];
+  }
+  const_reference front() const {
+    if (empty()) {
+      throw std::out_of_range("block_deque::front on empty deque");
+    }
+    return (*this)[0];
+  }
+
+  reference back() {
+    if (empty()) {
+      throw std::out_of_range("block_deque::back on empty deque");
+    }
+    return (*this)[size_ - 1];
+  }
+  const_reference back() const {
+    if (empty()) {
+      throw std::out_of_range("block_deque::back on empty deque");
+    }
+    return (*this)[size_ - 1];
+  }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  iterator end() noexcept { return iterator(this, size_); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(cend());
+  }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(cbegin());
+  }
+
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(cend());
+  }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(cbegin());
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  // 当前分配了的块数
+  size_type block_count() const noexcept {
+    return size_ == 0 ? 0 : block_of(start_ + size_ - 1) - block_of(start_) + 1;
+  }
+
+  // 析构所有元素并归还所有块，map_ 保留
+  void clear() noexcept {
+    while (size_ > 0) {
+      pop_back_unchecked();
+    }
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  void push_front(const T &value) { emplace_front(value); }
+  void push_front(T &&value) { emplace_front(std::move(value)); }
+
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    size_type pos = start_ + size_;
+    if (block_of(pos) == map_size_) {
+      reshape_map(false);
+      pos = start_ + size_;
+    }
+    bool fresh = ensure_block(block_of(pos));
+    try {
+      std::construct_at(slot(pos), std::forward<Args>(args)...);
+    } catch (...) {
+      if (fresh) {
+        free_block(block_of(pos));
+      }
+      throw;
+    }
+    ++size_;
+    return *slot(pos);
+  }
+  template <typename... Args> reference emplace_front(Args &&...args) {
+    if (start_ == 0) {
+      reshape_map(true);
+    }
+    size_type pos = start_ - 1;
+    bool fresh = ensure_block(block_of(pos));
+    try {
+      std::construct_at(slot(pos), std::forward<Args>(args)...);
+    } catch (...) {
+      if (fresh) {
+        free_block(block_of(pos));
+      }
+      throw;
+    }
+    start_ = pos;
+    ++size_;
+    return *slot(pos);
+  }
+
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("block_deque::pop_back on empty deque");
+    }
+    pop_back_unchecked();
+  }
+  void pop_front() {
+    if (empty()) {
+      throw std::out_of_range("block_deque::pop_front on empty deque");
+    }
+
+    std::destroy_at(slot(start_));
+    ++start_;
+    --size_;
+    // 头部的块用完了就还回去
+    if (size_ == 0) {
+      free_block(block_of(start_ - 1));
+      recenter_empty();
+    } else if (offset_of(start_) == 0) {
+      free_block(block_of(start_ - 1));
+    }
+  }
+
+  iterator insert(const_iterator pos, const T &value) {
+    return emplace_at(pos.index_, value);
+  }
+  iterator insert(const_iterator pos, T &&value) {
+    return emplace_at(pos.index_, std::move(value));
+  }
+  // 在 pos 处插入 count 个 value
+  iterator insert(const_iterator pos, size_type count, const T &value) {
+    T tmp(value); // value 可能引用本队列内的元素
+    return insert_range(pos.index_, repeat_iterator{&tmp, 0},
+                        repeat_iterator{&tmp, count});
+  }
+  // 在 pos 处插入 [first, last)；区间不能引用本队列内的元素
+  template <std::input_iterator InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    return insert_range(pos.index_, first, last);
+  }
+  iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
+    return insert_range(pos.index_, ilist.begin(), ilist.end());
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type first_index = first - cbegin();
+    size_type last_index = last - cbegin();
+
+    if (first_index > last_index || last_index > size_) {
+      throw std::out_of_range("block_deque::erase range out of range");
+    }
+
+    size_type count = last_index - first_index;
+    if (count == 0) {
+      return begin() + static_cast<difference_type>(first_index);
+    }
+
+    if (first_index < size_ - last_index) {
+      // 前面的元素少：整体后移，再从头部弹出
+      for (size_type i = first_index; i > 0; --i) {
+        (*this)[i - 1 + count] = std::move((*this)[i - 1]);
+      }
+      for (size_type i = 0; i < count; ++i) {
+        pop_front();
+      }
+    } else {
+      for (size_type i = first_index; i + count < size_; ++i) {
+        (*this)[i] = std::move((*this)[i + count]);
+      }
+      for (size_type i = 0; i < count; ++i) {
+        pop_back_unchecked();
+      }
+    }
+
+    return begin() + static_cast<difference_type>(first_index);
+  }
+
+  void resize(size_type count) {
+    while (size_ > count) {
+      pop_back_unchecked();
+    }
+    while (size_ < count) {
+      emplace_back();
+    }
+  }
+  void resize(size_type count, const T &value) {
+    while (size_ > count) {
+      pop_back_unchecked();
+    }
+    while (size_ < count) {
+      push_back(value);
+    }
+  }
+
+  // 二进制快照（格式见 snapshot.hpp）：每块一段，按逻辑顺序一次写出
+  void save(std::ostream &out) const
+    requires snapshottable<T>
+  {
+    save_snapshot_to(out);
+  }
+  void save(int fd) const
+    requires snapshottable<T>
+  {
+    save_snapshot_to(fd);
+  }
+
+  // 先读进一块连续的临时缓冲区，校验通过后再分块放入；
+  // 出错时抛异常，原有内容不变
+  void load(std::istream &in)
+    requires snapshottable<T>
+  {
+    load_snapshot_from(in);
+  }
+  void load(int fd)
+    requires snapshottable<T>
+  {
+    load_snapshot_from(fd);
+  }
+
+  void swap(block_deque &other) noexcept {
+    std::swap(map_, other.map_);
+    std::swap(map_size_, other.map_size_);
+    std::swap(start_, other.start_);
+    std::swap(size_, other.size_);
+  }
+
+private:
+  static constexpr size_type block_shift = std::countr_zero(block_size);
+  static constexpr size_type min_map_size = 8;
+
+  // map_ 里不在 [block_of(start_), block_of(start_ + size_ - 1)] 上的都是空指针。
+  // start_ 是第一个元素在"所有块首尾相接"这个坐标系里的位置
+  std::unique_ptr<T *[]> map_;
+  size_type map_size_{0};
+  size_type start_{0};
+  size_type size_{0};
+
+  static size_type block_of(size_type pos) noexcept {
+    return pos >> block_shift;
+  }
+  static size_type offset_of(size_type pos) noexcept {
+    return pos & (block_size - 1);
+  }
+  T *slot(size_type pos) const noexcept {
+    return map_[block_of(pos)] + offset_of(pos);
+  }
+
+  // 同一个值重复若干次的前向"迭代器"，用计数比较相等
+  struct repeat_iterator {
+    const T *value;
+    size_type count;
+
+    const T &operator*() const noexcept { return *value; }
+    repeat_iterator &operator++() noexcept {
+      ++count;
+      return *this;
+    }
+    bool operator==(const repeat_iterator &other) const noexcept {
+      return count == other.count;
+    }
+  };
+
+  // 块不存在就分配一个，返回是否新分配
+  bool ensure_block(size_type block) {
+    if (map_[block] != nullptr) {
+      return false;
+    }
+    map_[block] = std::allocator<T>{}.allocate(block_size);
+    return true;
+  }
+  void free_block(size_type block) noexcept {
+    std::allocator<T>{}.deallocate(map_[block], block_size);
+    map_[block] = nullptr;
+  }
+
+  void pop_back_unchecked() noexcept {
+    --size_;
+    size_type pos = start_ + size_;
+    std::destroy_at(slot(pos));
+    // 尾部的块空了就还回去
+    if (size_ == 0) {
+      free_block(block_of(pos));
+      recenter_empty();
+    } else if (offset_of(pos) == 0) {
+      free_block(block_of(pos));
+    }
+  }
+
+  // 空队列从 map_ 中间重新开始，两端都留出空间
+  void recenter_empty() noexcept {
+    start_ = (map_size_ / 2) << block_shift;
+  }
+
+  // 一端没有空槽位时调用：已用的块指针居中放进 map_，
+  // 空槽位不到一半时先把 map_ 扩成两倍。只搬指针，不动元素
+  void reshape_map(bool at_front) {
+    size_type first = block_of(start_);
+    size_type used = block_count();
+    size_type needed = used + 1;
+
+    size_type new_size = map_size_;
+    if (needed * 2 > map_size_) {
+      new_size = std::max(min_map_size, map_size_ * 2);
+      while (new_size < needed * 2) {
+        new_size *= 2;
+      }
+    }
+    // 新块那一侧多留一个槽位
+    size_type new_first = (new_size - needed) / 2 + (at_front ? 1 : 0);
+
+    if (new_size != map_size_) {
+      auto new_map = std::make_unique<T *[]>(new_size);
+      std::copy(map_.get() + first, map_.get() + first + used,
+                new_map.get() + new_first);
+      map_ = std::move(new_map);
+      map_size_ = new_size;
+    } else if (new_first < first) {
+      std::copy(map_.get() + first, map_.get() + first + used,
+                map_.get() + new_first);
+      std::fill(map_.get() + std::max(first, new_first + used),
+                map_.get() + first + used, nullptr);
+    } else if (new_first > first) {
+      std::copy_backward(map_.get() + first, map_.get() + first + used,
+                         map_.get() + new_first + used);
+      std::fill(map_.get() + first,
+                map_.get() + std::min(new_first, first + used), nullptr);
+    }
+    start_ = (new_first << block_shift) + offset_of(start_);
+  }
+
+  // 只移动 index 前后较短的那一段
+  template <typename U> iterator emplace_at(size_type index, U &&value) {
+    if (index > size_) {
+      throw std::out_of_range("block_deque::insert position out of range");
+    }
+    if (index == size_) {
+      emplace_back(std::forward<U>(value));
+      return iterator(this, index);
+    }
+    if (index == 0) {
+      emplace_front(std::forward<U>(value));
+      return iterator(this, index);
+    }
+
+    T tmp(std::forward<U>(value)); // value 可能引用本队列内的元素
+    if (index < size_ - index) {
+      emplace_front(std::move((*this)[0]));
+      for (size_type i = 1; i < index; ++i) {
+        (*this)[i] = std::move((*this)[i + 1]);
+      }
+    } else {
+      emplace_back(std::move((*this)[size_ - 1]));
+      for (size_type i = size_ - 2; i > index; --i) {
+        (*this)[i] = std::move((*this)[i - 1]);
+      }
+    }
+    (*this)[index] = std::move(tmp);
+    return iterator(this, index);
+  }
+
+  // 新元素先逐个放到离 index 较近的一端，再旋转到位，
+  // 只移动较短的那一段；中途抛异常时撤掉已放入的新元素
+  template <typename It>
+  iterator insert_range(size_type index, It first, It last) {
+    if (index > size_) {
+      throw std::out_of_range("block_deque::insert position out of range");
+    }
+
+    size_type added = 0;
+    bool at_front = index < size_ - index;
+    try {
+      for (; first != last; ++first, ++added) {
+        if (at_front) {
+          emplace_front(*first);
+        } else {
+          emplace_back(*first);
+        }
+      }
+    } catch (...) {
+      for (; added > 0; --added) {
+        at_front ? pop_front() : pop_back_unchecked();
+      }
+      throw;
+    }
+
+    auto n = static_cast<difference_type>(added);
+    auto at = static_cast<difference_type>(index);
+    if (at_front) {
+      // 头部的新元素是倒序放进去的
+      std::reverse(begin(), begin() + n);
+      std::rotate(begin(), begin() + n, begin() + n + at);
+    } else {
+      std::rotate(begin() + at, end() - n, end());
+    }
+    return begin() + at;
+  }
+
+
+  template <typename Sink> void save_snapshot_to(Sink &sink) const {
+    size_type blocks = block_count();
+    auto iov = std::make_unique<iovec[]>(blocks + 1);
+    size_type pos = start_;
+    size_type end = start_ + size_;
+    for (size_type i = 1; i <= blocks; ++i) {
+      size_type n = std::min(block_size - offset_of(pos), end - pos);
+      iov[i] = {slot(pos), n * sizeof(T)};
+      pos += n;
+    }
+    detail::save_snapshot_segments<T>(sink, iov.get(),
+                                      static_cast<int>(blocks));
+  }
+
+  template <typename Source> void load_snapshot_from(Source &source) {
+    std::unique_ptr<T[]> buffer;
+    size_type count = 0;
+    detail::load_snapshot<T>(source, [&](size_type n) {
+      buffer = std::make_unique_for_overwrite<T[]>(n);
+      count = n;
+      return buffer.get();
+    });
+    block_deque tmp;
+    for (size_type i = 0; i < count; ++i) {
+      tmp.push_back(buffer[i]);
+    }
+    swap(tmp);
+  }
+};
+
 } // namespace my_stl
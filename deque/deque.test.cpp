@@ -1,10 +1,60 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <random>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "deque.h"
 
+namespace {
+// 在随机位置做单个、多个、区间插入和区间删除，结果与 std::deque 比较
+template <typename Deque> void check_random_edits() {
+  Deque d;
+  std::deque<int> expected;
+  std::mt19937 rng(42);
+  for (int round = 0; round < 2000; ++round) {
+    auto pos = static_cast<std::ptrdiff_t>(rng() % (expected.size() + 1));
+    int value = static_cast<int>(rng() % 1000);
+    switch (rng() % 5) {
+    case 0:
+      d.insert(d.begin() + pos, value);
+      expected.insert(expected.begin() + pos, value);
+      break;
+    case 1: {
+      std::size_t count = rng() % 20;
+      d.insert(d.begin() + pos, count, value);
+      expected.insert(expected.begin() + pos, count, value);
+      break;
+    }
+    case 2: {
+      std::list<int> source{value, value + 1, value + 2};
+      d.insert(d.begin() + pos, source.begin(), source.end());
+      expected.insert(expected.begin() + pos, source.begin(), source.end());
+      break;
+    }
+    default: {
+      auto len = std::min<std::ptrdiff_t>(
+          static_cast<std::ptrdiff_t>(expected.size()) - pos, 15);
+      len = static_cast<std::ptrdiff_t>(rng() % (len + 1));
+      d.erase(d.begin() + pos, d.begin() + pos + len);
+      expected.erase(expected.begin() + pos, expected.begin() + pos + len);
+      break;
+    }
+    }
+    REQUIRE(d.size() == expected.size());
+  }
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    REQUIRE(d[i] == expected[i]);
+  }
+}
+} // namespace
+
 TEST_CASE("my_stl::deque can be default constructed") {
   my_stl::deque<int> d;
   (void)d;
@@ -187,3 +237,479 @@ TEST_CASE("my_stl::deque resize and swap work together") {
   REQUIRE(other.size() == 1);
   REQUIRE(other.front() == 1);
 }
+
+TEST_CASE("my_stl::deque grows across reallocation") {
+  my_stl::deque<int, my_stl::grow_2x> d;
+
+  for (int i = 0; i < 4; ++i) {
+    d.push_back(i);
+  }
+  d.push_front(-1);
+  d.insert(d.begin() + 2, 100);
+
+  REQUIRE(d.size() == 6);
+  REQUIRE(d[0] == -1);
+  REQUIRE(d[1] == 0);
+  REQUIRE(d[2] == 100);
+  REQUIRE(d[5] == 3);
+}
+
+TEST_CASE("my_stl::deque capacity is always a power of two") {
+  REQUIRE(my_stl::deque<int>().capacity() == 0);
+  REQUIRE(my_stl::deque<int>(5).capacity() == 8);
+  REQUIRE(my_stl::deque<int>(8, 1).capacity() == 8);
+  REQUIRE(my_stl::deque<int>{1, 2, 3}.capacity() == 4);
+
+  // 一次插入多个时，容量取整到放得下的 2 的幂
+  my_stl::deque<int> d;
+  for (int i = 0; i < 10; ++i) {
+    d.push_back(i);
+    REQUIRE((d.capacity() & (d.capacity() - 1)) == 0);
+  }
+  REQUIRE(d.capacity() == 16);
+  d.insert(d.begin(), 20, 7);
+  REQUIRE(d.capacity() == 32);
+
+  // 反复从两端进出，让 front 绕过缓冲区末尾
+  my_stl::deque<int> ring(5);
+  for (int i = 0; i < 100; ++i) {
+    ring.pop_front();
+    ring.push_back(i);
+    ring.push_front(-i);
+    ring.pop_back();
+  }
+  REQUIRE(ring.size() == 5);
+  REQUIRE(ring.capacity() == 8);
+  REQUIRE(ring.front() == -99);
+  REQUIRE(ring[1] == 0);
+  REQUIRE(ring[4] == 0);
+}
+
+TEST_CASE("my_stl::deque snapshot writes wrapped storage in logical order") {
+  my_stl::deque<std::int32_t> d;
+  for (std::int32_t i = 0; i < 6; ++i) {
+    d.push_back(i);
+  }
+  // 让环形缓冲区绕回到开头，数据分成两段
+  d.pop_front();
+  d.pop_front();
+  d.push_back(6);
+  d.push_back(7);
+
+  std::stringstream stream;
+  d.save(stream);
+  REQUIRE(stream.str().size() == 64 + 6 * sizeof(std::int32_t));
+
+  my_stl::deque<std::int32_t> restored{42};
+  restored.load(stream);
+  REQUIRE(restored.size() == 6);
+  for (std::int32_t i = 0; i < 6; ++i) {
+    REQUIRE(restored[i] == i + 2);
+  }
+  restored.push_front(1);
+  REQUIRE(restored.front() == 1);
+
+  std::stringstream empty_stream;
+  my_stl::deque<std::int32_t>().save(empty_stream);
+  restored.load(empty_stream);
+  REQUIRE(restored.empty());
+
+  std::stringstream wrong(std::string(64, 'x'));
+  REQUIRE_THROWS_AS(restored.load(wrong), std::runtime_error);
+}
+
+TEST_CASE("my_stl::deque as_spans splits wrapped storage in two") {
+  my_stl::deque<int> d;
+  auto [empty_head, empty_tail] = d.as_spans();
+  REQUIRE(empty_head.empty());
+  REQUIRE(empty_tail.empty());
+
+  for (int i = 0; i < 5; ++i) {
+    d.push_back(i);
+  }
+  auto [head, tail] = std::as_const(d).as_spans();
+  REQUIRE(head.size() == 5);
+  REQUIRE(tail.empty());
+
+  // 往前推会绕到缓冲区末尾，数据分成两段
+  d.push_front(-1);
+  d.push_front(-2);
+  auto [front_part, back_part] = d.as_spans();
+  REQUIRE(front_part.size() == 2);
+  REQUIRE(front_part[0] == -2);
+  REQUIRE(back_part.size() == 5);
+  REQUIRE(back_part[0] == 0);
+  REQUIRE(back_part.data() == &d[2]);
+}
+
+TEST_CASE("my_stl::deque iterators cross the wrap point") {
+  my_stl::deque<int> d;
+  for (int i = 0; i < 6; ++i) {
+    d.push_back(i);
+  }
+  for (int i = 1; i <= 10; ++i) {
+    d.push_front(-i);
+  }
+  REQUIRE(d.capacity() == 16);
+
+  int expected = -10;
+  for (int x : d) {
+    REQUIRE(x == expected++);
+  }
+  REQUIRE(expected == 6);
+
+  expected = 5;
+  for (auto it = d.crbegin(); it != d.crend(); ++it) {
+    REQUIRE(*it == expected--);
+  }
+
+  for (std::ptrdiff_t from = 0; from <= 16; ++from) {
+    for (std::ptrdiff_t to = 0; to <= 16; ++to) {
+      auto it = d.begin() + from;
+      it += to - from;
+      REQUIRE(it - d.begin() == to);
+      if (to < 16) {
+        REQUIRE(*it == d[static_cast<std::size_t>(to)]);
+      }
+    }
+  }
+
+  auto it = d.end();
+  --it;
+  REQUIRE(*it == 5);
+  it -= 6;
+  REQUIRE(*it == -1);
+  --it;
+  REQUIRE(*it == -2);
+  REQUIRE(it[2] == 0);
+  REQUIRE(d.cbegin() < it);
+  REQUIRE(it == d.begin() + 8);
+}
+
+TEST_CASE("my_stl::deque segment algorithms see the logical order") {
+  my_stl::deque<int> d;
+  for (int i = 0; i < 4; ++i) {
+    d.push_back(i);
+    d.push_front(-1 - i);
+  }
+  // -4 -3 -2 -1 0 1 2 3，跨越绕回点
+
+  std::vector<int> out;
+  my_stl::copy(d, std::back_inserter(out));
+  REQUIRE(out == std::vector<int>{-4, -3, -2, -1, 0, 1, 2, 3});
+
+  REQUIRE(my_stl::accumulate(d, 0) == -4);
+  REQUIRE(my_stl::accumulate(d, 1L, [](long acc, int x) {
+            return x == 0 ? acc : acc * x;
+          }) == 144);
+
+  REQUIRE(my_stl::find(d, -3) == d.begin() + 1);
+  REQUIRE(my_stl::find(d, 2) == d.begin() + 6);
+  REQUIRE(my_stl::find(std::as_const(d), 7) == d.cend());
+  *my_stl::find(d, 0) = 100;
+  REQUIRE(d[4] == 100);
+
+  int visited = 0;
+  my_stl::for_each(d, [&](int &x) {
+    x += 1;
+    ++visited;
+  });
+  REQUIRE(visited == 8);
+  REQUIRE(d.front() == -3);
+  REQUIRE(d.back() == 4);
+
+  my_stl::fill(d, 9);
+  std::string text;
+  my_stl::for_each(std::as_const(d),
+                   [&](const int &x) { text += std::to_string(x); });
+  REQUIRE(text == "99999999");
+
+  my_stl::deque<std::string> words{"a", "bb", "ccc"};
+  words.push_front("z");
+  REQUIRE(my_stl::find(words, std::string("ccc")) == words.begin() + 3);
+  REQUIRE(my_stl::accumulate(words, std::string()) == "zabbccc");
+}
+
+TEST_CASE("my_stl::deque bulk append and drain across the wrap point") {
+  my_stl::deque<std::uint8_t> ring;
+  const std::string text = "hello, ring buffer";
+  auto bytes = reinterpret_cast<const std::uint8_t *>(text.data());
+
+  ring.append(bytes, 10);
+  REQUIRE(ring.size() == 10);
+  REQUIRE(ring.capacity() == 16);
+  ring.consume(8);
+  // 再追加 12 个字节：末尾剩 6 个空位，其余绕回开头
+  ring.append(bytes + 6, 12);
+  REQUIRE(ring.size() == 14);
+  REQUIRE(ring.capacity() == 16);
+  REQUIRE(!ring.as_spans().second.empty());
+
+  std::string out(14, '\0');
+  auto dst = reinterpret_cast<std::uint8_t *>(out.data());
+  REQUIRE(ring.peek(dst, 100) == 14);
+  REQUIRE(out == text.substr(8, 2) + text.substr(6, 12));
+  REQUIRE(ring.size() == 14);
+
+  REQUIRE(ring.drain_into(dst, 5) == 5);
+  REQUIRE(out.substr(0, 5) == "in ri");
+  REQUIRE(ring.front() == 'n');
+  REQUIRE(ring.drain_into(dst, 100) == 9);
+  REQUIRE(ring.empty());
+  REQUIRE(ring.drain_into(dst, 1) == 0);
+
+  REQUIRE_THROWS_AS(ring.consume(1), std::out_of_range);
+
+  // 扩容时保留原来的顺序
+  ring.append(bytes, 12);
+  ring.consume(10);
+  ring.append(bytes, text.size());
+  REQUIRE(ring.size() == 2 + text.size());
+  REQUIRE(ring.capacity() == 32);
+  REQUIRE(ring[0] == 'g');
+  REQUIRE(ring[2] == 'h');
+  REQUIRE(ring.back() == 'r');
+}
+
+TEST_CASE("my_stl::deque writable_spans are filled in place") {
+  my_stl::deque<int> d;
+  auto [none, none_tail] = d.writable_spans();
+  REQUIRE(none.empty());
+  REQUIRE(none_tail.empty());
+
+  for (int i = 0; i < 6; ++i) {
+    d.push_back(i);
+  }
+  d.consume(5); // 只剩 5，在下标 5 的位置
+  auto [head, tail] = d.writable_spans(7);
+  REQUIRE(head.size() + tail.size() == d.capacity() - 1);
+  REQUIRE(head.size() == 2);
+  REQUIRE(tail.data() == &d.front() - 5);
+
+  // 模拟 readv：先写满第一段，再写第二段的一部分
+  int next = 6;
+  for (int &slot : head) {
+    slot = next++;
+  }
+  for (std::size_t i = 0; i < 3; ++i) {
+    tail[i] = next++;
+  }
+  d.commit(5);
+  REQUIRE(d.size() == 6);
+  for (int i = 0; i < 6; ++i) {
+    REQUIRE(d[static_cast<std::size_t>(i)] == i + 5);
+  }
+  REQUIRE_THROWS_AS(d.commit(3), std::out_of_range);
+
+  // 空位不够时先扩容
+  auto [grown_head, grown_tail] = d.writable_spans(100);
+  REQUIRE(grown_head.size() + grown_tail.size() >= 100);
+  REQUIRE(d.size() == 6);
+  REQUIRE(d.front() == 5);
+  REQUIRE(d.back() == 10);
+
+  my_stl::deque<std::string> words{"a", "b"};
+  std::string more[] = {"c", "d", "e"};
+  words.append(more, 3);
+  std::string taken[4];
+  REQUIRE(words.drain_into(taken, 4) == 4);
+  REQUIRE(taken[3] == "d");
+  REQUIRE(words.front() == "e");
+}
+
+TEST_CASE("my_stl::block_deque pushes never move existing elements") {
+  my_stl::block_deque<std::string> d;
+  d.push_back("middle");
+  const std::string *middle = &d.front();
+
+  // 两端各推几个块的元素，map_ 要扩容、居中好几次
+  for (int i = 0; i < 5000; ++i) {
+    d.push_back(std::to_string(i));
+    d.push_front(std::to_string(-i));
+  }
+  REQUIRE(d.size() == 10001);
+  REQUIRE(&d[5000] == middle);
+  REQUIRE(*middle == "middle");
+  REQUIRE(d.front() == "-4999");
+  REQUIRE(d.back() == "4999");
+  REQUIRE(d.block_count() > 2);
+
+  for (int i = 0; i < 5000; ++i) {
+    d.pop_front();
+  }
+  REQUIRE(&d.front() == middle);
+  while (d.size() > 1) {
+    d.pop_back();
+  }
+  REQUIRE(&d.front() == middle);
+  REQUIRE(d.block_count() == 1);
+
+  d.pop_back();
+  REQUIRE(d.empty());
+  REQUIRE(d.block_count() == 0);
+  REQUIRE_THROWS_AS(d.pop_front(), std::out_of_range);
+}
+
+TEST_CASE("my_stl::block_deque matches the deque interface") {
+  my_stl::block_deque<int> d{1, 2, 3};
+  d.push_front(0);
+  d.insert(d.begin() + 2, 100);
+  REQUIRE(d.size() == 5);
+  REQUIRE(d[2] == 100);
+  REQUIRE(d.at(4) == 3);
+  REQUIRE_THROWS_AS(d.at(5), std::out_of_range);
+
+  d.erase(d.begin(), d.begin() + 2);
+  REQUIRE(d.front() == 100);
+  REQUIRE(d.size() == 3);
+
+  my_stl::block_deque<int> copy = d;
+  copy.push_back(7);
+  my_stl::block_deque<int> moved = std::move(copy);
+  REQUIRE(moved.size() == 4);
+  REQUIRE(*moved.rbegin() == 7);
+  REQUIRE(d.size() == 3);
+
+  d.resize(1000, 9);
+  REQUIRE(d.size() == 1000);
+  REQUIRE(d[999] == 9);
+  d.resize(2);
+  REQUIRE(d.back() == 2);
+
+  int sum = 0;
+  for (int x : std::as_const(moved)) {
+    sum += x;
+  }
+  REQUIRE(sum == 100 + 2 + 3 + 7);
+
+  my_stl::block_deque<int> sized(300);
+  REQUIRE(sized.size() == 300);
+  REQUIRE(sized[299] == 0);
+  sized.clear();
+  REQUIRE(sized.empty());
+}
+
+TEST_CASE("my_stl::block_deque erases strings without clobbering them") {
+  my_stl::block_deque<std::string> d;
+  for (int i = 0; i < 6; ++i) {
+    d.push_back("item-" + std::to_string(i));
+  }
+
+  // 空区间：两侧都不动
+  d.erase(d.begin() + 1, d.begin() + 1);
+  d.erase(d.begin() + 4, d.begin() + 4);
+  REQUIRE(d.size() == 6);
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    REQUIRE(d[i] == "item-" + std::to_string(i));
+  }
+
+  // 单个元素：靠前的从前面补，靠后的从后面补
+  auto it = d.erase(d.begin() + 1);
+  REQUIRE(*it == "item-2");
+  it = d.erase(d.begin() + 3);
+  REQUIRE(*it == "item-5");
+  REQUIRE(d.size() == 4);
+  REQUIRE(d[0] == "item-0");
+  REQUIRE(d[1] == "item-2");
+  REQUIRE(d[2] == "item-3");
+  REQUIRE(d[3] == "item-5");
+
+  it = d.erase(d.end() - 1);
+  REQUIRE(it == d.end());
+  REQUIRE(d.back() == "item-3");
+}
+
+TEST_CASE("my_stl::block_deque snapshot writes every block in order") {
+  my_stl::block_deque<std::int32_t> d;
+  for (std::int32_t i = 0; i < 3000; ++i) {
+    d.push_back(i);
+  }
+  for (std::int32_t i = 0; i < 500; ++i) {
+    d.pop_front();
+    d.push_front(-1);
+    d.pop_front();
+  }
+
+  std::stringstream stream;
+  d.save(stream);
+  REQUIRE(stream.str().size() == 64 + 2500 * sizeof(std::int32_t));
+
+  // 和 deque 的快照格式相同，可以互相读
+  my_stl::deque<std::int32_t> ring;
+  ring.load(stream);
+  REQUIRE(ring.size() == 2500);
+  REQUIRE(ring[0] == 500);
+  REQUIRE(ring[2499] == 2999);
+
+  std::stringstream back;
+  ring.save(back);
+  my_stl::block_deque<std::int32_t> restored{1};
+  restored.load(back);
+  REQUIRE(restored.size() == 2500);
+  for (std::size_t i = 0; i < restored.size(); ++i) {
+    REQUIRE(restored[i] == static_cast<std::int32_t>(i) + 500);
+  }
+}
+
+TEST_CASE("my_stl::deque insert and erase shift the shorter side") {
+  my_stl::deque<int> d;
+  for (int i = 0; i < 8; ++i) {
+    d.push_back(i);
+  }
+  // 在头部附近插入，前半段前移，front 绕到缓冲区末尾
+  d.insert(d.begin() + 1, {100, 101});
+  REQUIRE(d.size() == 10);
+  REQUIRE(d[0] == 0);
+  REQUIRE(d[1] == 100);
+  REQUIRE(d[2] == 101);
+  REQUIRE(d[3] == 1);
+  REQUIRE(d.back() == 7);
+
+  d.insert(d.end() - 1, 3, -1);
+  REQUIRE(d.size() == 13);
+  REQUIRE(d[8] == 6);
+  REQUIRE(d[9] == -1);
+  REQUIRE(d[12] == 7);
+
+  d.erase(d.begin() + 1, d.begin() + 3);
+  REQUIRE(d.front() == 0);
+  REQUIRE(d[1] == 1);
+
+  // 插入的值引用了自己的元素
+  d.insert(d.begin() + 2, d[0]);
+  REQUIRE(d[2] == 0);
+
+  check_random_edits<my_stl::deque<int>>();
+}
+
+TEST_CASE("my_stl::block_deque insert and erase shift the shorter side") {
+  my_stl::block_deque<int> d{0, 1, 2, 3, 4, 5, 6, 7};
+  const int *last = &d.back();
+  d.insert(d.begin() + 1, {100, 101});
+  d.erase(d.begin() + 2);
+  // 只动了前半段，尾部元素的地址不变
+  REQUIRE(&d.back() == last);
+  REQUIRE(d[1] == 100);
+  REQUIRE(d[2] == 1);
+
+  check_random_edits<my_stl::block_deque<int>>();
+}
+
+TEST_CASE("my_stl::block_deque empty-range erase leaves elements intact") {
+  // 空区间不能把较短一侧的元素移动到自己身上，否则 vector 会被清空
+  my_stl::block_deque<std::vector<int>> d;
+  for (int i = 0; i < 8; ++i) {
+    d.push_back(std::vector<int>(3, i));
+  }
+
+  auto it = d.erase(d.begin() + 1, d.begin() + 1); // 前面一侧较短
+  REQUIRE(it == d.begin() + 1);
+  it = d.erase(d.begin() + 5, d.begin() + 5); // 后面一侧较短
+  REQUIRE(it == d.begin() + 5);
+  d.erase(d.end(), d.end());
+
+  REQUIRE(d.size() == 8);
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    REQUIRE(d[i] == std::vector<int>(3, static_cast<int>(i)));
+  }
+}
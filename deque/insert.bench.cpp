@@ -0,0 +1,90 @@
+#include "deque.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+
+// 在 1M 元素的 deque 里按不同位置插入/删除：
+// 旧做法总是移动尾部，新做法移动离插入点较近的一端
+
+namespace {
+
+constexpr std::size_t kSize = 1'000'000;
+constexpr int kOps = 200;
+constexpr std::size_t kRange = 1000;
+
+using u64 = std::uint64_t;
+
+// 改动前的 insert：尾部整体右移一位
+void insert_shift_tail(my_stl::deque<u64> &d, std::size_t index, u64 value) {
+  d.push_back(d.back());
+  for (std::size_t i = d.size() - 2; i > index; --i) {
+    d[i] = d[i - 1];
+  }
+  d[index] = value;
+}
+
+template <typename F> double us_per_op(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kOps; ++i) {
+    f();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(stop - start).count() /
+         kOps;
+}
+
+template <typename Deque> Deque make_filled() {
+  Deque d;
+  for (std::size_t i = 0; i < kSize; ++i) {
+    d.push_back(i);
+  }
+  return d;
+}
+
+} // namespace
+
+int main() {
+  std::printf("deque of %zu uint64_t, us per operation\n", kSize);
+  std::printf("%-9s %12s %12s %12s %12s\n", "position", "old insert",
+              "insert", "erase", "std insert");
+
+  const double positions[] = {0.001, 0.1, 0.5, 0.9, 0.999};
+  for (double where : positions) {
+    auto index = static_cast<std::size_t>(where * kSize);
+    auto at = static_cast<std::ptrdiff_t>(index);
+
+    auto old_d = make_filled<my_stl::deque<u64>>();
+    double old_us = us_per_op([&] { insert_shift_tail(old_d, index, 1); });
+
+    auto d = make_filled<my_stl::deque<u64>>();
+    double new_us = us_per_op([&] { d.insert(d.begin() + at, u64{1}); });
+    double erase_us = us_per_op([&] { d.erase(d.begin() + at); });
+
+    auto ref = make_filled<std::deque<u64>>();
+    double std_us = us_per_op([&] { ref.insert(ref.begin() + at, 1); });
+
+    std::printf("%7.1f%%  %12.1f %12.1f %12.1f %12.1f\n", where * 100, old_us,
+                new_us, erase_us, std_us);
+  }
+
+  // 一次插入 kRange 个元素：逐个插入和区间插入（只腾一次位置）
+  auto one_by_one = make_filled<my_stl::deque<u64>>();
+  auto ranged = make_filled<my_stl::deque<u64>>();
+  std::deque<u64> source(kRange, 7);
+  auto at = static_cast<std::ptrdiff_t>(kSize / 4);
+  double single_us = us_per_op([&] {
+    for (u64 v : source) {
+      one_by_one.insert(one_by_one.begin() + at, v);
+    }
+  });
+  double range_us = us_per_op([&] {
+    ranged.insert(ranged.begin() + at, source.begin(), source.end());
+  });
+  std::printf("%zu elements at 25%%: one by one %.1f us  range %.1f us "
+              "(%.0fx)\n",
+              kRange, single_us, range_us, single_us / range_us);
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include "deque.h"
+#include "vector/vector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+
+// 增长过程中单次 push 的耗时分布：环形 deque 满了要整体搬移，
+// 分块的 block_deque 和 std::deque 只分配新块、偶尔重排指针数组
+
+namespace {
+
+constexpr std::size_t kPushes = 8'000'000;
+
+template <typename Queue> void bench_one(const char *name) {
+  my_stl::vector<std::uint32_t> samples;
+  samples.resize(kPushes);
+
+  Queue q;
+  auto total_start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < kPushes; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    if (i % 2 == 0) {
+      q.push_back(i);
+    } else {
+      q.push_front(i);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    samples[i] = static_cast<std::uint32_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+            .count());
+  }
+  auto total_stop = std::chrono::steady_clock::now();
+
+  auto percentile = [&](double p) {
+    auto nth = samples.begin() +
+               static_cast<std::ptrdiff_t>(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+  };
+  double total_ms =
+      std::chrono::duration<double, std::milli>(total_stop - total_start)
+          .count();
+  std::printf("%-20s total %7.1f ms  p50 %5u  p99 %5u  p99.9 %6u  "
+              "p99.99 %7u  max %9u ns\n",
+              name, total_ms, percentile(0.5), percentile(0.99),
+              percentile(0.999), percentile(0.9999), percentile(1.0));
+}
+
+} // namespace
+
+int main() {
+  using u64 = std::uint64_t;
+  std::printf("%zu pushes alternating between both ends, per-push latency "
+              "(includes ~20 ns clock overhead)\n",
+              kPushes);
+  bench_one<my_stl::deque<u64>>("deque (ring)");
+  bench_one<my_stl::block_deque<u64>>("block_deque");
+  bench_one<std::deque<u64>>("std::deque");
+  return 0;
+}
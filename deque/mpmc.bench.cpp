@@ -0,0 +1,141 @@
+#include "deque.h"
+#include "mpmc_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 多个线程争同一条队列：互斥锁保护的 my_stl::deque 和 mpmc_queue 对比，
+// 线程数从 1 翻倍到 hardware_concurrency（至少到 4）。
+// pairs：每个线程交替 push、pop，队列几乎不会满或空，只测争用；
+// split：一半线程只生产、一半只消费，消费者经常要等，测等待策略
+
+namespace {
+
+constexpr std::size_t kOpsPerThread = 500'000;
+constexpr std::size_t kCapacity = 1024;
+
+// 改动前的做法：一把锁保护 deque，满（空）时解锁后让出 CPU 再试
+class locked_queue {
+public:
+  explicit locked_queue(std::size_t capacity) : capacity_(capacity) {}
+  void push(std::uint64_t value) {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.size() < capacity_) {
+          items_.push_back(value);
+          return;
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+  std::uint64_t pop() {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!items_.empty()) {
+          std::uint64_t value = items_.front();
+          items_.pop_front();
+          return value;
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  std::mutex mutex_;
+  my_stl::deque<std::uint64_t> items_;
+  std::size_t capacity_;
+};
+
+using spin_queue = my_stl::mpmc_queue<std::uint64_t, my_stl::spin_wait>;
+using futex_queue = my_stl::mpmc_queue<std::uint64_t, my_stl::futex_wait>;
+
+// 所有线程的总吞吐，百万次操作（一次 push 或一次 pop）每秒
+template <typename Queue> double bench_pairs(std::size_t threads) {
+  Queue queue(kCapacity);
+  std::vector<std::thread> workers;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&queue, t] {
+      std::uint64_t sum = 0;
+      for (std::size_t i = 0; i < kOpsPerThread; ++i) {
+        queue.push(t + i);
+        sum += queue.pop();
+      }
+      volatile std::uint64_t sink = sum;
+      (void)sink;
+    });
+  }
+  for (std::thread &w : workers) {
+    w.join();
+  }
+  std::chrono::duration<double, std::micro> us =
+      std::chrono::steady_clock::now() - start;
+  return 2.0 * threads * kOpsPerThread / us.count();
+}
+
+template <typename Queue> double bench_split(std::size_t threads) {
+  std::size_t producers = std::max<std::size_t>(threads / 2, 1);
+  std::size_t consumers = std::max<std::size_t>(threads - producers, 1);
+  std::size_t total = producers * kOpsPerThread;
+  Queue queue(kCapacity);
+  std::vector<std::thread> workers;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t p = 0; p < producers; ++p) {
+    workers.emplace_back([&queue] {
+      for (std::size_t i = 0; i < kOpsPerThread; ++i) {
+        queue.push(i);
+      }
+    });
+  }
+  for (std::size_t c = 0; c < consumers; ++c) {
+    // 消费者平分总数，余数给第一个
+    std::size_t share = total / consumers + (c == 0 ? total % consumers : 0);
+    workers.emplace_back([&queue, share] {
+      for (std::size_t i = 0; i < share; ++i) {
+        queue.pop();
+      }
+    });
+  }
+  for (std::thread &w : workers) {
+    w.join();
+  }
+  std::chrono::duration<double, std::micro> us =
+      std::chrono::steady_clock::now() - start;
+  return 2.0 * total / us.count();
+}
+
+} // namespace
+
+int main() {
+  unsigned hw = std::thread::hardware_concurrency();
+  std::size_t max_threads = std::max(4u, hw);
+  std::printf("%u hardware threads, capacity %zu, %zu ops per thread, "
+              "M ops/s\n",
+              hw, kCapacity, kOpsPerThread);
+  std::printf("threads  workload  mutex+deque  mpmc spin  mpmc futex\n");
+
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    double locked = bench_pairs<locked_queue>(threads);
+    double spin = bench_pairs<spin_queue>(threads);
+    double futex = bench_pairs<futex_queue>(threads);
+    std::printf("%7zu  pairs     %11.1f  %9.1f  %10.1f\n", threads, locked,
+                spin, futex);
+
+    locked = bench_split<locked_queue>(threads);
+    spin = bench_split<spin_queue>(threads);
+    futex = bench_split<futex_queue>(threads);
+    std::printf("%7zu  split     %11.1f  %9.1f  %10.1f\n", threads, locked,
+                spin, futex);
+  }
+  return 0;
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace my_stl {
+
+// mpmc_queue 的等待策略。每个策略提供
+//   wait(try_op)：反复调用 try_op，直到它返回 true；
+//   notify()：另一端成功操作后调用，唤醒可能在 wait 里睡着的线程。
+
+// 只自旋，notify 什么都不做；适合线程数不超过核数、很少真正等待的场景
+struct spin_wait {
+  template <typename TryOp> void wait(TryOp try_op) {
+    for (unsigned spins = 0; !try_op(); ++spins) {
+      if (spins >= 64) {
+        std::this_thread::yield();
+      }
+    }
+  }
+  void notify() noexcept {}
+};
+
+// 先像 spin_wait 一样短暂自旋，仍然失败就在一个 32 位计数上睡眠
+// （std::atomic::wait，Linux 上就是 futex），对端操作成功后递增计数并
+// 唤醒一个线程。只有存在等待者时 notify 才会真正进内核，
+// 没人等待时只多一次 fence 和读取
+struct futex_wait {
+  template <typename TryOp> void wait(TryOp try_op) {
+    for (unsigned spins = 0; spins < 128; ++spins) {
+      if (try_op()) {
+        return;
+      }
+      if (spins >= 64) {
+        std::this_thread::yield();
+      }
+    }
+    while (!try_op()) {
+      // 先记下计数再登记、再重试：之后的 notify 一定会改变计数，
+      // 之前的 notify 对应的元素一定能被这次重试看到
+      std::uint32_t seen = epoch_.load(std::memory_order_acquire);
+      waiters_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (try_op()) {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
+      epoch_.wait(seen, std::memory_order_acquire);
+      waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+  void notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) != 0) {
+      epoch_.fetch_add(1, std::memory_order_release);
+      epoch_.notify_one();
+    }
+  }
+
+private:
+  std::atomic<std::uint32_t> epoch_{0};
+  std::atomic<std::uint32_t> waiters_{0};
+};
+
+// 有界的多生产者、多消费者无锁队列（Dmitry Vyukov 的做法）。
+// 每个槽位带一个序号：等于 pos 表示空、可以写入第 pos 个元素，
+// 等于 pos + 1 表示第 pos 个元素已写好、可以读取。
+// 生产者和消费者各自只在一个位置计数器上 CAS，不会争同一把锁，
+// 槽位的序号负责两边的同步。
+//
+// try_push/try_pop 不阻塞；push/pop 队列满（空）时按 Wait 策略等待。
+// T 的移动构造不能抛异常：槽位被占下之后就没法撤回了。
+template <typename T, typename Wait = spin_wait> class mpmc_queue {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "mpmc_queue requires a nothrow move constructor");
+  static constexpr std::size_t cache_line = 64;
+
+  struct cell {
+    std::atomic<std::size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *value() noexcept {
+      return std::launder(reinterpret_cast<T *>(storage));
+    }
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // 容量向上取整到 2 的幂，至少为 2（序号区分空和满需要两个槽位）
+  explicit mpmc_queue(size_type capacity)
+      : mask_(ring_capacity(capacity) - 1),
+        cells_(std::make_unique<cell[]>(mask_ + 1)) {
+    for (size_type i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+  // 析构时不能再有其他线程访问队列
+  ~mpmc_queue() {
+    size_type last = enqueue_pos_.load(std::memory_order_relaxed);
+    for (size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+         pos != last; ++pos) {
+      std::destroy_at(cells_[pos & mask_].value());
+    }
+  }
+
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  // 只是某一时刻的近似值
+  size_type size_approx() const noexcept {
+    size_type head = dequeue_pos_.load(std::memory_order_acquire);
+    size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+  bool empty() const noexcept { return size_approx() == 0; }
+
+  // ===== 非阻塞 =====
+
+  // 队列满时返回 false，value 不会被移动
+  bool try_push(const T &value) { return try_push(T(value)); }
+  bool try_push(T &&value) {
+    size_type pos;
+    cell *c = claim_push(pos);
+    if (c == nullptr) {
+      return false;
+    }
+    publish(c, pos, std::move(value));
+    return true;
+  }
+
+  // 队列空时返回 false，out 不变
+  bool try_pop(T &out) {
+    size_type pos;
+    cell *c = claim_pop(pos);
+    if (c == nullptr) {
+      return false;
+    }
+    // 先移出来、还回槽位，赋值抛异常也不会卡住队列
+    T value(std::move(*c->value()));
+    release(c, pos);
+    out = std::move(value);
+    return true;
+  }
+
+  // ===== 阻塞 =====
+
+  void push(const T &value) { push(T(value)); }
+  void push(T &&value) {
+    size_type pos;
+    cell *c = nullptr;
+    not_full_.wait([&] { return (c = claim_push(pos)) != nullptr; });
+    publish(c, pos, std::move(value));
+  }
+
+  T pop() {
+    size_type pos;
+    cell *c = nullptr;
+    not_empty_.wait([&] { return (c = claim_pop(pos)) != nullptr; });
+    T value(std::move(*c->value()));
+    release(c, pos);
+    return value;
+  }
+
+private:
+  alignas(cache_line) std::atomic<size_type> enqueue_pos_{0};
+  alignas(cache_line) std::atomic<size_type> dequeue_pos_{0};
+  // 构造后只读
+  alignas(cache_line) const size_type mask_;
+  const std::unique_ptr<cell[]> cells_;
+  alignas(cache_line) Wait not_empty_; // 消费者在这里等
+  alignas(cache_line) Wait not_full_;  // 生产者在这里等
+
+  static size_type ring_capacity(size_type count) {
+    if (count == 0) {
+      throw std::invalid_argument("mpmc_queue capacity must be positive");
+    }
+    if (count > std::numeric_limits<size_type>::max() / 2 + 1) {
+      throw std::length_error("mpmc_queue capacity overflow");
+    }
+    return std::bit_ceil(std::max<size_type>(count, 2));
+  }
+
+  // 占下第 pos 个写入位置；队列满时返回 nullptr
+  cell *claim_push(size_type &pos) noexcept {
+    pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell *c = &cells_[pos & mask_];
+      size_type seq = c->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          return c;
+        }
+      } else if (diff < 0) {
+        return nullptr; // 这个槽位上一轮的元素还没被取走
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  // 占下第 pos 个读取位置；队列空时返回 nullptr
+  cell *claim_pop(size_type &pos) noexcept {
+    pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell *c = &cells_[pos & mask_];
+      size_type seq = c->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          return c;
+        }
+      } else if (diff < 0) {
+        return nullptr; // 第 pos 个元素还没写好
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void publish(cell *c, size_type pos, T &&value) noexcept {
+    std::construct_at(c->value(), std::move(value));
+    c->sequence.store(pos + 1, std::memory_order_release);
+    not_empty_.notify();
+  }
+  // 槽位留给下一轮的第 pos + capacity 个元素
+  void release(cell *c, size_type pos) noexcept {
+    std::destroy_at(c->value());
+    c->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    not_full_.notify();
+  }
+};
+
+} // namespace my_stl
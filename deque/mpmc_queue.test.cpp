@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mpmc_queue.h"
+
+namespace {
+// producers 个线程各 push count 个数，consumers 个线程一起 pop，
+// 检查每个数恰好被取出一次
+template <typename Wait>
+void check_fan_in_fan_out(std::size_t producers, std::size_t consumers) {
+  constexpr std::size_t count = 20'000;
+  my_stl::mpmc_queue<std::size_t, Wait> queue(16);
+  std::size_t total = producers * count;
+  std::vector<std::atomic<int>> seen(total);
+  std::atomic<std::size_t> taken{0};
+
+  std::vector<std::thread> threads;
+  for (std::size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (std::size_t i = 0; i < count; ++i) {
+        queue.push(p * count + i);
+      }
+    });
+  }
+  for (std::size_t c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      while (taken.fetch_add(1) < total) {
+        seen[queue.pop()].fetch_add(1);
+      }
+    });
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+
+  bool exactly_once = true;
+  for (auto &s : seen) {
+    exactly_once = exactly_once && s.load() == 1;
+  }
+  REQUIRE(exactly_once);
+  REQUIRE(queue.empty());
+}
+} // namespace
+
+TEST_CASE("my_stl::mpmc_queue rounds capacity up to a power of two") {
+  REQUIRE(my_stl::mpmc_queue<int>(5).capacity() == 8);
+  REQUIRE(my_stl::mpmc_queue<int>(1).capacity() == 2);
+  REQUIRE_THROWS_AS(my_stl::mpmc_queue<int>(0), std::invalid_argument);
+}
+
+TEST_CASE("my_stl::mpmc_queue try_push and try_pop keep FIFO order") {
+  my_stl::mpmc_queue<std::string> queue(4);
+  REQUIRE(queue.empty());
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE(queue.try_push(std::to_string(i)));
+  }
+  std::string extra = "extra";
+  REQUIRE_FALSE(queue.try_push(std::move(extra)));
+  REQUIRE(extra == "extra");
+  REQUIRE(queue.size_approx() == 4);
+
+  std::string out;
+  REQUIRE(queue.try_pop(out));
+  REQUIRE(out == "0");
+  queue.push("4");
+  for (int i = 1; i <= 4; ++i) {
+    REQUIRE(queue.pop() == std::to_string(i));
+  }
+  REQUIRE_FALSE(queue.try_pop(out));
+  REQUIRE(out == "0");
+}
+
+TEST_CASE("my_stl::mpmc_queue holds move-only values and destroys leftovers") {
+  auto tracked = std::make_shared<int>(7);
+  {
+    my_stl::mpmc_queue<std::shared_ptr<int>> queue(4);
+    queue.push(tracked);
+    queue.push(tracked);
+    queue.push(tracked);
+    REQUIRE(tracked.use_count() == 4);
+    queue.pop();
+    REQUIRE(tracked.use_count() == 3);
+  }
+  REQUIRE(tracked.use_count() == 1);
+
+  my_stl::mpmc_queue<std::unique_ptr<int>> owners(2);
+  owners.push(std::make_unique<int>(1));
+  REQUIRE(owners.try_push(std::make_unique<int>(2)));
+  REQUIRE(*owners.pop() == 1);
+  std::unique_ptr<int> out;
+  REQUIRE(owners.try_pop(out));
+  REQUIRE(*out == 2);
+}
+
+TEST_CASE("my_stl::mpmc_queue delivers every item exactly once") {
+  SECTION("spin_wait") { check_fan_in_fan_out<my_stl::spin_wait>(3, 3); }
+  SECTION("futex_wait, more producers") {
+    check_fan_in_fan_out<my_stl::futex_wait>(4, 2);
+  }
+  SECTION("futex_wait, more consumers") {
+    check_fan_in_fan_out<my_stl::futex_wait>(2, 4);
+  }
+}
@@ -0,0 +1,93 @@
+#include "deque.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// 把 deque<uint8_t> 当作收发环形缓冲区：每次写进一个包、读出一个包，
+// 逐字节 push_back/pop_front 和批量 append/drain_into、writable_spans 对比
+
+namespace {
+
+constexpr std::size_t kPacket = 1500;
+constexpr std::size_t kBacklog = 64 * 1024; // 缓冲区里常驻的字节数
+constexpr std::size_t kPackets = 200'000;
+
+using ring_t = my_stl::deque<std::uint8_t>;
+
+template <typename F> double ns_per_byte(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         (kPackets * kPacket);
+}
+
+ring_t make_ring() {
+  ring_t ring;
+  for (std::size_t i = 0; i < kBacklog; ++i) {
+    ring.push_back(static_cast<std::uint8_t>(i));
+  }
+  return ring;
+}
+
+} // namespace
+
+int main() {
+  std::vector<std::uint8_t> in(kPacket);
+  std::vector<std::uint8_t> out(kPacket);
+  for (std::size_t i = 0; i < kPacket; ++i) {
+    in[i] = static_cast<std::uint8_t>(i * 7);
+  }
+  std::printf("%zu packets of %zu bytes, %zu bytes kept in the ring\n",
+              kPackets, kPacket, kBacklog);
+
+  volatile std::uint8_t sink = 0;
+
+  ring_t bytewise = make_ring();
+  double per_byte = ns_per_byte([&] {
+    for (std::size_t p = 0; p < kPackets; ++p) {
+      for (std::size_t i = 0; i < kPacket; ++i) {
+        bytewise.push_back(in[i]);
+      }
+      for (std::size_t i = 0; i < kPacket; ++i) {
+        out[i] = bytewise.front();
+        bytewise.pop_front();
+      }
+    }
+    sink = out[0];
+  });
+
+  ring_t bulk = make_ring();
+  double per_bulk = ns_per_byte([&] {
+    for (std::size_t p = 0; p < kPackets; ++p) {
+      bulk.append(in.data(), kPacket);
+      bulk.drain_into(out.data(), kPacket);
+    }
+    sink = out[0];
+  });
+
+  // 模拟 readv：直接写进空闲的两段，再 commit
+  ring_t spans = make_ring();
+  double per_span = ns_per_byte([&] {
+    for (std::size_t p = 0; p < kPackets; ++p) {
+      auto [head, tail] = spans.writable_spans(kPacket);
+      std::size_t first = std::min(kPacket, head.size());
+      std::memcpy(head.data(), in.data(), first);
+      std::memcpy(tail.data(), in.data() + first, kPacket - first);
+      spans.commit(kPacket);
+      spans.drain_into(out.data(), kPacket);
+    }
+    sink = out[0];
+  });
+
+  std::printf("push_back/pop_front  %6.3f ns/byte\n", per_byte);
+  std::printf("append/drain_into    %6.3f ns/byte (%.0fx)\n", per_bulk,
+              per_byte / per_bulk);
+  std::printf("writable_spans       %6.3f ns/byte (%.0fx)\n", per_span,
+              per_byte / per_span);
+  return 0;
+}
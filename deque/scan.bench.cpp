@@ -0,0 +1,106 @@
+#include "deque.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+// 整个 deque 顺序扫描：逐个 operator[]、迭代器、按 as_spans() 分段的算法。
+// 数据跨越绕回点，分成两段。
+// 也试过缓存元素指针、只在缓冲区末尾绕回的迭代器：绕回判断编译成 cmov，
+// 成了循环携带的依赖链，扫描反而比按下标的迭代器慢一倍，所以没有采用
+
+namespace {
+
+constexpr std::size_t kLen = 1 << 20;
+constexpr int kRounds = 200;
+
+using deque_t = my_stl::deque<std::int32_t>;
+
+template <typename F> double us_per_scan(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    f();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(stop - start).count() /
+         kRounds;
+}
+
+deque_t make_wrapped() {
+  deque_t d;
+  for (std::size_t i = 0; i < kLen / 2; ++i) {
+    d.push_back(static_cast<std::int32_t>(i % 1000));
+    d.push_front(static_cast<std::int32_t>(i % 1000));
+  }
+  return d;
+}
+
+void report(const char *name, double index, double iter, double spans) {
+  std::printf("%-10s operator[] %8.1f us  iterator %8.1f us  "
+              "as_spans %8.1f us\n",
+              name, index, iter, spans);
+}
+
+} // namespace
+
+int main() {
+  deque_t d = make_wrapped();
+  const deque_t &cd = d;
+  auto [head, tail] = cd.as_spans();
+  std::printf("%zu int32 elements, segments %zu + %zu\n", d.size(),
+              head.size(), tail.size());
+
+  volatile std::int64_t sink = 0;
+
+  double sum_index = us_per_scan([&] {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < cd.size(); ++i) {
+      sum += cd[i];
+    }
+    sink = sum;
+  });
+  double sum_iter = us_per_scan([&] {
+    sink = std::accumulate(cd.begin(), cd.end(), std::int64_t{0});
+  });
+  double sum_spans =
+      us_per_scan([&] { sink = my_stl::accumulate(cd, std::int64_t{0}); });
+  report("sum", sum_index, sum_iter, sum_spans);
+
+  // 找一个不存在的值，扫完整个 deque
+  constexpr std::int32_t missing = -1;
+  double find_index = us_per_scan([&] {
+    std::size_t i = 0;
+    while (i < cd.size() && cd[i] != missing) {
+      ++i;
+    }
+    sink = static_cast<std::int64_t>(i);
+  });
+  double find_iter = us_per_scan([&] {
+    sink = std::find(cd.begin(), cd.end(), missing) - cd.begin();
+  });
+  double find_spans = us_per_scan(
+      [&] { sink = my_stl::find(cd, missing) - cd.begin(); });
+  report("find", find_index, find_iter, find_spans);
+
+  std::vector<std::int32_t> out(d.size());
+  double copy_index = us_per_scan([&] {
+    for (std::size_t i = 0; i < cd.size(); ++i) {
+      out[i] = cd[i];
+    }
+    sink = out[kLen / 2];
+  });
+  double copy_iter = us_per_scan([&] {
+    std::copy(cd.begin(), cd.end(), out.begin());
+    sink = out[kLen / 2];
+  });
+  double copy_spans = us_per_scan([&] {
+    my_stl::copy(cd, out.begin());
+    sink = out[kLen / 2];
+  });
+  report("copy", copy_index, copy_iter, copy_spans);
+  return 0;
+}
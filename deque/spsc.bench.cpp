@@ -0,0 +1,185 @@
+#include "deque.h"
+#include "spsc_ring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// 两个线程之间传递消息：互斥锁保护的 my_stl::deque 和 spsc_ring 对比。
+// ping-pong：两条队列来回传一个计数，测往返延迟；
+// 吞吐：生产者不停地写、消费者不停地读，测每秒搬运的消息数。
+// Linux 下两个线程分别绑定到 0 号和 1 号核（只有一个核时都在 0 号核上，
+// 等待时让出 CPU，数字主要反映调度开销）
+
+namespace {
+
+constexpr std::size_t kRoundTrips = 200'000;
+constexpr std::size_t kMessages = 20'000'000;
+constexpr std::size_t kCapacity = 1024;
+constexpr std::size_t kBatch = 32;
+
+void pin_to_core(unsigned core) {
+#ifdef __linux__
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core % cores, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)core;
+#endif
+}
+
+// 单核时自旋没有意义，等待时让出 CPU
+void relax() {
+  static const bool single_core = std::thread::hardware_concurrency() < 2;
+  if (single_core) {
+    std::this_thread::yield();
+  }
+}
+
+// 改动前的做法：一把锁保护 deque
+class locked_queue {
+public:
+  explicit locked_queue(std::size_t) {}
+  bool try_push(std::uint64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    items_.push_back(value);
+    return true;
+  }
+  bool try_pop(std::uint64_t &out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (items_.empty()) {
+      return false;
+    }
+    out = items_.front();
+    items_.pop_front();
+    return true;
+  }
+  std::size_t try_push_n(const std::uint64_t *src, std::size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    items_.append(src, n);
+    return n;
+  }
+  std::size_t try_pop_n(std::uint64_t *dst, std::size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.drain_into(dst, n);
+  }
+
+private:
+  std::mutex mutex_;
+  my_stl::deque<std::uint64_t> items_;
+};
+
+using spsc_queue = my_stl::spsc_ring<std::uint64_t>;
+
+double elapsed_ns(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// 往返一次的平均纳秒数
+template <typename Queue> double bench_ping_pong() {
+  Queue ping(kCapacity);
+  Queue pong(kCapacity);
+  std::thread echo([&] {
+    pin_to_core(1);
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < kRoundTrips; ++i) {
+      while (!ping.try_pop(value)) {
+        relax();
+      }
+      while (!pong.try_push(value + 1)) {
+        relax();
+      }
+    }
+  });
+
+  pin_to_core(0);
+  auto start = std::chrono::steady_clock::now();
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < kRoundTrips; ++i) {
+    while (!ping.try_push(value)) {
+      relax();
+    }
+    while (!pong.try_pop(value)) {
+      relax();
+    }
+  }
+  double ns = elapsed_ns(start) / kRoundTrips;
+  echo.join();
+  return value == kRoundTrips ? ns : -1.0;
+}
+
+// 每秒百万条消息；Batch 为 1 时逐条 try_push/try_pop
+template <typename Queue, std::size_t Batch> double bench_throughput() {
+  Queue queue(kCapacity);
+  std::thread producer([&] {
+    pin_to_core(1);
+    std::uint64_t batch[Batch];
+    std::uint64_t next = 0;
+    while (next < kMessages) {
+      std::size_t n = std::min<std::size_t>(Batch, kMessages - next);
+      for (std::size_t i = 0; i < n; ++i) {
+        batch[i] = next + i;
+      }
+      std::size_t pushed = Batch == 1 ? queue.try_push(batch[0])
+                                      : queue.try_push_n(batch, n);
+      next += pushed;
+      if (pushed == 0) {
+        relax();
+      }
+    }
+  });
+
+  pin_to_core(0);
+  auto start = std::chrono::steady_clock::now();
+  std::uint64_t batch[Batch];
+  std::uint64_t sum = 0;
+  std::size_t received = 0;
+  while (received < kMessages) {
+    std::size_t n = Batch == 1 ? queue.try_pop(batch[0])
+                               : queue.try_pop_n(batch, Batch);
+    for (std::size_t i = 0; i < n; ++i) {
+      sum += batch[i];
+    }
+    received += n;
+    if (n == 0) {
+      relax();
+    }
+  }
+  double ns = elapsed_ns(start);
+  producer.join();
+  bool ok = sum == std::uint64_t{kMessages} * (kMessages - 1) / 2;
+  return ok ? kMessages / ns * 1e3 : -1.0;
+}
+
+} // namespace
+
+int main() {
+  std::printf("%u hardware threads, ring capacity %zu, batch %zu\n",
+              std::thread::hardware_concurrency(), kCapacity, kBatch);
+
+  std::printf("ping-pong round trip  mutex+deque %7.1f ns   "
+              "spsc_ring %7.1f ns\n",
+              bench_ping_pong<locked_queue>(), bench_ping_pong<spsc_queue>());
+  std::printf("throughput, single    mutex+deque %7.1f M/s  "
+              "spsc_ring %7.1f M/s\n",
+              bench_throughput<locked_queue, 1>(),
+              bench_throughput<spsc_queue, 1>());
+  std::printf("throughput, batch     mutex+deque %7.1f M/s  "
+              "spsc_ring %7.1f M/s\n",
+              bench_throughput<locked_queue, kBatch>(),
+              bench_throughput<spsc_queue, kBatch>());
+  return 0;
+}
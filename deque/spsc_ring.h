@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace my_stl {
+
+// 单生产者、单消费者的无锁环形队列，用于两个固定线程之间传递消息。
+// 下标换算和 deque 一样：容量是 2 的幂，physical_index 只做一次按位与。
+// head_/tail_ 单调递增、不回绕，差值就是元素个数。
+//
+// 只能有一个线程调用 try_push*，一个线程调用 try_pop*；
+// size_approx/empty 可以在任意线程调用，结果只是某一时刻的近似值。
+//
+// 每个线程把对方的下标缓存在自己的 cache line 上，只有缓存显示
+// 队列满（空）时才重新读取对方的原子变量，减少 cache line 来回传递。
+// 槽位是预先构造好的 T，pop 出去的元素留下被移动过的对象。
+template <typename T> class spsc_ring {
+  static constexpr std::size_t cache_line = 64;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // 容量向上取整到 2 的幂
+  explicit spsc_ring(size_type capacity)
+      : mask_(ring_capacity(capacity) - 1),
+        slots_(std::make_unique<T[]>(mask_ + 1)) {}
+
+  spsc_ring(const spsc_ring &) = delete;
+  spsc_ring &operator=(const spsc_ring &) = delete;
+
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  size_type size_approx() const noexcept {
+    size_type head = head_.load(std::memory_order_acquire);
+    size_type tail = tail_.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : 0;
+  }
+  bool empty() const noexcept { return size_approx() == 0; }
+
+  // ===== 生产者 =====
+
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  // 队列满时返回 false，args 不会被使用
+  template <typename... Args> bool try_emplace(Args &&...args) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    if (free_slots(tail) == 0) {
+      return false;
+    }
+    slots_[physical_index(tail)] = T(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 拷贝 [src, src + n) 中能放下的前缀，返回放进去的个数。
+  // 最多拷贝两段连续区域，整批只发布一次 tail_
+  size_type try_push_n(const T *src, size_type n) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    n = std::min(n, free_slots(tail, n));
+    if (n == 0) {
+      return 0;
+    }
+    size_type pos = physical_index(tail);
+    size_type first = std::min(n, capacity() - pos);
+    std::copy_n(src, first, slots_.get() + pos);
+    std::copy_n(src + first, n - first, slots_.get());
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  // ===== 消费者 =====
+
+  // 队列空时返回 false，out 不变
+  bool try_pop(T &out) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (ready_slots(head) == 0) {
+      return false;
+    }
+    out = std::move(slots_[physical_index(head)]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 取出至多 n 个元素移动到 dst，返回取出的个数
+  size_type try_pop_n(T *dst, size_type n) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    n = std::min(n, ready_slots(head, n));
+    if (n == 0) {
+      return 0;
+    }
+    size_type pos = physical_index(head);
+    size_type first = std::min(n, capacity() - pos);
+    T *base = slots_.get();
+    std::move(base + pos, base + pos + first, dst);
+    std::move(base, base + (n - first), dst + first);
+    head_.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+private:
+  // 生产者写、消费者读
+  alignas(cache_line) std::atomic<size_type> tail_{0};
+  size_type cached_head_{0}; // 生产者看到的 head_
+  // 消费者写、生产者读
+  alignas(cache_line) std::atomic<size_type> head_{0};
+  size_type cached_tail_{0}; // 消费者看到的 tail_
+  // 构造后只读，两边共享也不会互相失效
+  alignas(cache_line) const size_type mask_;
+  const std::unique_ptr<T[]> slots_;
+
+  static size_type ring_capacity(size_type count) {
+    if (count == 0) {
+      throw std::invalid_argument("spsc_ring capacity must be positive");
+    }
+    if (count > std::numeric_limits<size_type>::max() / 2 + 1) {
+      throw std::length_error("spsc_ring capacity overflow");
+    }
+    return std::bit_ceil(count);
+  }
+
+  size_type physical_index(size_type index) const noexcept {
+    return index & mask_;
+  }
+
+  // 至少要 wanted 个空位时，缓存不够才重新读 head_
+  size_type free_slots(size_type tail, size_type wanted = 1) noexcept {
+    size_type free = capacity() - (tail - cached_head_);
+    if (free < wanted) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      free = capacity() - (tail - cached_head_);
+    }
+    return free;
+  }
+  size_type ready_slots(size_type head, size_type wanted = 1) noexcept {
+    size_type ready = cached_tail_ - head;
+    if (ready < wanted) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      ready = cached_tail_ - head;
+    }
+    return ready;
+  }
+};
+
+} // namespace my_stl
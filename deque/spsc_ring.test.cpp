@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spsc_ring.h"
+
+TEST_CASE("my_stl::spsc_ring rounds capacity up to a power of two") {
+  my_stl::spsc_ring<int> ring(5);
+  REQUIRE(ring.capacity() == 8);
+  REQUIRE(ring.empty());
+  REQUIRE(my_stl::spsc_ring<int>(1).capacity() == 1);
+  REQUIRE_THROWS_AS(my_stl::spsc_ring<int>(0), std::invalid_argument);
+}
+
+TEST_CASE("my_stl::spsc_ring push and pop keep FIFO order") {
+  my_stl::spsc_ring<std::string> ring(4);
+  REQUIRE(ring.try_push("a"));
+  REQUIRE(ring.try_emplace(3, 'b'));
+  std::string c = "c";
+  REQUIRE(ring.try_push(c));
+  REQUIRE(ring.try_push(std::move(c)));
+  REQUIRE_FALSE(ring.try_push("full"));
+  REQUIRE(ring.size_approx() == 4);
+
+  std::string out;
+  REQUIRE(ring.try_pop(out));
+  REQUIRE(out == "a");
+  REQUIRE(ring.try_pop(out));
+  REQUIRE(out == "bbb");
+  REQUIRE(ring.try_push("d"));
+  REQUIRE(ring.try_pop(out));
+  REQUIRE(ring.try_pop(out));
+  REQUIRE(ring.try_pop(out));
+  REQUIRE(out == "d");
+  REQUIRE_FALSE(ring.try_pop(out));
+  REQUIRE(out == "d");
+}
+
+TEST_CASE("my_stl::spsc_ring batches wrap around the buffer end") {
+  my_stl::spsc_ring<int> ring(8);
+  int in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  int out[10] = {};
+
+  REQUIRE(ring.try_push_n(in, 6) == 6);
+  REQUIRE(ring.try_pop_n(out, 5) == 5);
+  REQUIRE(out[4] == 4);
+  // 从下标 6 开始写 7 个，后 5 个绕回开头；只放得下 7 个
+  REQUIRE(ring.try_push_n(in, 10) == 7);
+  REQUIRE(ring.try_push_n(in, 1) == 0);
+  REQUIRE(ring.size_approx() == 8);
+
+  REQUIRE(ring.try_pop_n(out, 10) == 8);
+  REQUIRE(out[0] == 5);
+  for (int i = 0; i < 7; ++i) {
+    REQUIRE(out[i + 1] == i);
+  }
+  REQUIRE(ring.try_pop_n(out, 10) == 0);
+  REQUIRE(ring.empty());
+}
+
+TEST_CASE("my_stl::spsc_ring hands every item across threads in order") {
+  constexpr std::size_t count = 50'000;
+  my_stl::spsc_ring<std::size_t> ring(64);
+
+  std::thread producer([&] {
+    std::size_t batch[7];
+    std::size_t next = 0;
+    while (next < count) {
+      if (next % 3 == 0) {
+        if (ring.try_push(next)) {
+          ++next;
+        }
+        continue;
+      }
+      std::size_t n = std::min<std::size_t>(7, count - next);
+      for (std::size_t i = 0; i < n; ++i) {
+        batch[i] = next + i;
+      }
+      std::size_t pushed = ring.try_push_n(batch, n);
+      next += pushed;
+      if (pushed == 0) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::vector<std::size_t> received;
+  received.reserve(count);
+  std::size_t batch[5];
+  while (received.size() < count) {
+    std::size_t n = ring.try_pop_n(batch, 5);
+    received.insert(received.end(), batch, batch + n);
+    if (n == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  bool in_order = true;
+  for (std::size_t i = 0; i < count; ++i) {
+    in_order = in_order && received[i] == i;
+  }
+  REQUIRE(in_order);
+  REQUIRE(ring.empty());
+}
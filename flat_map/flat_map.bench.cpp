@@ -0,0 +1,111 @@
+#include "flat_map.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <span>
+#include <random>
+#include <utility>
+#include <vector>
+
+// 查找：std::map、std::lower_bound、无分支二分、SIMD 线性扫描；
+// 构建：逐个 insert 和一次批量 insert
+
+namespace {
+
+constexpr std::size_t kLookups = 4'000'000;
+
+template <typename F> double ns_per_op(std::size_t ops, F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         static_cast<double>(ops);
+}
+
+void bench_lookup(std::size_t n) {
+  std::mt19937 rng(static_cast<std::uint32_t>(n));
+  std::vector<std::pair<std::int32_t, std::int32_t>> items;
+  for (std::size_t i = 0; i < n; ++i) {
+    items.emplace_back(static_cast<std::int32_t>(i * 3), 1);
+  }
+  std::vector<std::int32_t> queries(kLookups);
+  for (std::int32_t &q : queries) {
+    q = static_cast<std::int32_t>(rng() % (n * 3));
+  }
+
+  std::map<std::int32_t, std::int32_t> tree(items.begin(), items.end());
+  my_stl::flat_map<std::int32_t, std::int32_t, std::less<std::int32_t>, 64>
+      scan_map;
+  scan_map.insert(items.begin(), items.end());
+  my_stl::flat_map<std::int32_t, std::int32_t> bsearch_map;
+  bsearch_map.insert(items.begin(), items.end());
+  std::span<const std::int32_t> keys = scan_map.keys();
+
+  std::size_t hits[4] = {};
+  double t_map = ns_per_op(kLookups, [&] {
+    for (std::int32_t q : queries) {
+      hits[0] += tree.find(q) != tree.end() ? 1 : 0;
+    }
+  });
+  double t_std = ns_per_op(kLookups, [&] {
+    for (std::int32_t q : queries) {
+      auto it = std::lower_bound(keys.begin(), keys.end(), q);
+      hits[1] += it != keys.end() && *it == q ? 1 : 0;
+    }
+  });
+  double t_branchless = ns_per_op(kLookups, [&] {
+    for (std::int32_t q : queries) {
+      hits[2] += bsearch_map.contains(q) ? 1 : 0;
+    }
+  });
+  double t_flat = ns_per_op(kLookups, [&] {
+    for (std::int32_t q : queries) {
+      hits[3] += scan_map.contains(q) ? 1 : 0;
+    }
+  });
+
+  bool same = hits[0] == hits[1] && hits[1] == hits[2] && hits[2] == hits[3];
+  std::printf("%8zu keys  std::map %6.1f  std::lower_bound %6.1f  "
+              "branchless %6.1f  scan<=64 %6.1f ns%s\n",
+              n, t_map, t_std, t_branchless, t_flat,
+              same ? "" : "  MISMATCH");
+}
+
+void bench_build(std::size_t n) {
+  std::mt19937 rng(7);
+  std::vector<std::pair<std::int32_t, std::int32_t>> items;
+  for (std::size_t i = 0; i < n; ++i) {
+    items.emplace_back(static_cast<std::int32_t>(rng()), 1);
+  }
+
+  my_stl::flat_map<std::int32_t, std::int32_t> one_by_one;
+  double t_single = ns_per_op(n, [&] {
+    for (const auto &item : items) {
+      one_by_one.insert(item);
+    }
+  });
+  my_stl::flat_map<std::int32_t, std::int32_t> bulk;
+  double t_bulk =
+      ns_per_op(n, [&] { bulk.insert(items.begin(), items.end()); });
+
+  std::printf("build %zu random keys: insert one by one %.1f ns/key, "
+              "bulk insert %.1f ns/key (%.0fx)%s\n",
+              n, t_single, t_bulk, t_single / t_bulk,
+              one_by_one.size() == bulk.size() ? "" : "  MISMATCH");
+}
+
+} // namespace
+
+int main() {
+  std::printf("%zu random lookups (about 1/3 hit), ns per lookup\n",
+              kLookups);
+  for (std::size_t n : {8, 32, 64, 256, 4096, 1 << 20}) {
+    bench_lookup(n);
+  }
+  bench_build(200'000);
+  return 0;
+}
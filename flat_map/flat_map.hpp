@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "flat_search.hpp"
+#include "vector/vector.hpp"
+
+namespace my_stl {
+
+// 有序 my_stl::vector 上的映射：键和值分别放在两个数组里，
+// 查找时只扫描紧凑的键数组，值数组只在命中后访问一次。
+// 适合读多写少的中小规模映射；单个插入/删除是 O(n) 的搬移，
+// 批量插入请用 insert(first, last)，只排序、合并一次。
+// LinearScanMax：元素不多于这个数时，find 改用 SIMD 线性扫描。默认关闭：
+// 在 flat_map.bench 里，小规模时无分支二分反而比扫描更快。
+//
+// 迭代器解引用得到 std::pair<const Key &, T &> 代理，
+// 任何插入或删除都会使迭代器和引用失效。
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          std::size_t LinearScanMax = 0>
+class flat_map {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using key_compare = Compare;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::pair<const Key &, T &>;
+  using const_reference = std::pair<const Key &, const T &>;
+
+  flat_map() = default;
+  explicit flat_map(const Compare &comp) : comp_(comp) {}
+  flat_map(std::initializer_list<value_type> ilist,
+           const Compare &comp = Compare())
+      : comp_(comp) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  template <typename Owner, typename Ref> class row_iterator {
+    friend class flat_map;
+
+    // 代理是临时对象，operator-> 需要一个能持有它的壳
+    struct arrow_proxy {
+      Ref ref;
+      Ref *operator->() noexcept { return &ref; }
+    };
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = typename flat_map::value_type;
+    using reference = Ref;
+
+    row_iterator() noexcept : owner_(nullptr), index_(0) {}
+    // iterator 可以转换成 const_iterator
+    template <typename O, typename R>
+      requires std::is_convertible_v<O *, Owner *>
+    row_iterator(const row_iterator<O, R> &other) noexcept
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const {
+      return reference(owner_->keys_[index_], owner_->values_[index_]);
+    }
+    arrow_proxy operator->() const { return arrow_proxy{**this}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    row_iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    row_iterator operator++(int) {
+      row_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    row_iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    row_iterator operator--(int) {
+      row_iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    row_iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    row_iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    row_iterator operator+(difference_type n) const {
+      return row_iterator(owner_, index_ + n);
+    }
+    row_iterator operator-(difference_type n) const {
+      return row_iterator(owner_, index_ - n);
+    }
+    difference_type operator-(const row_iterator &rhs) const {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(rhs.index_);
+    }
+    friend row_iterator operator+(difference_type n, const row_iterator &it) {
+      return it + n;
+    }
+
+    auto operator<=>(const row_iterator &) const = default;
+
+  private:
+    template <typename, typename> friend class row_iterator;
+
+    Owner *owner_;
+    size_type index_;
+
+    row_iterator(Owner *owner, size_type index)
+        : owner_(owner), index_(index) {}
+  };
+
+  using iterator = row_iterator<flat_map, reference>;
+  using const_iterator = row_iterator<const flat_map, const_reference>;
+
+  size_type size() const noexcept { return keys_.size(); }
+  bool empty() const noexcept { return keys_.empty(); }
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+  void reserve(size_type n) {
+    keys_.reserve(n);
+    values_.reserve(n);
+  }
+
+  // 两个数组各自的连续视图，下标一一对应
+  std::span<const Key> keys() const noexcept {
+    return {keys_.data(), keys_.size()};
+  }
+  std::span<T> values() noexcept { return {values_.data(), values_.size()}; }
+  std::span<const T> values() const noexcept {
+    return {values_.data(), values_.size()};
+  }
+
+  T &at(const Key &key) {
+    size_type pos = find_index(key);
+    if (pos == size())
+      throw std::out_of_range("flat_map::at key not found");
+    return values_[pos];
+  }
+  const T &at(const Key &key) const {
+    size_type pos = find_index(key);
+    if (pos == size())
+      throw std::out_of_range("flat_map::at key not found");
+    return values_[pos];
+  }
+
+  // 不存在时插入一个值初始化的 T
+  T &operator[](const Key &key) {
+    return values_[try_emplace_index(key).first];
+  }
+  T &operator[](Key &&key) {
+    return values_[try_emplace_index(std::move(key)).first];
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return try_emplace(value.first, value.second);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+
+  // 键不存在时才用 args 构造值
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    auto [pos, inserted] =
+        try_emplace_index(key, std::forward<Args>(args)...);
+    return {iterator(this, pos), inserted};
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    auto [pos, inserted] =
+        try_emplace_index(std::move(key), std::forward<Args>(args)...);
+    return {iterator(this, pos), inserted};
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    auto [pos, inserted] = try_emplace_index(key, std::forward<M>(obj));
+    if (!inserted) {
+      values_[pos] = std::forward<M>(obj);
+    }
+    return {iterator(this, pos), inserted};
+  }
+
+  // 批量插入：新元素先按键稳定排序，再和原有元素归并到新数组里，
+  // 整体 O(n log n + size())。已有的键优先，新元素之间重复时保留先出现的
+  template <std::input_iterator InputIt>
+  void insert(InputIt first, InputIt last) {
+    vector<value_type> incoming;
+    for (; first != last; ++first) {
+      incoming.emplace_back(*first);
+    }
+    if (incoming.empty()) {
+      return;
+    }
+    std::stable_sort(incoming.begin(), incoming.end(),
+                     [this](const value_type &a, const value_type &b) {
+                       return comp_(a.first, b.first);
+                     });
+
+    vector<Key> keys;
+    vector<T> values;
+    keys.reserve(size() + incoming.size());
+    values.reserve(size() + incoming.size());
+
+    size_type i = 0;
+    size_type j = 0;
+    while (i < size() || j < incoming.size()) {
+      if (j == incoming.size() ||
+          (i < size() && !comp_(incoming[j].first, keys_[i]))) {
+        keys.push_back(std::move(keys_[i]));
+        values.push_back(std::move(values_[i]));
+        ++i;
+      } else {
+        keys.push_back(std::move(incoming[j].first));
+        values.push_back(std::move(incoming[j].second));
+        ++j;
+      }
+      // 跳过和刚放进去的键等价的新元素
+      while (j < incoming.size() && !comp_(keys.back(), incoming[j].first)) {
+        ++j;
+      }
+    }
+
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+  }
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // 删除键为 key 的元素，返回删除的个数
+  size_type erase(const Key &key) {
+    size_type pos = find_index(key);
+    if (pos == size()) {
+      return 0;
+    }
+    erase_index(pos);
+    return 1;
+  }
+  iterator erase(const_iterator pos) {
+    erase_index(pos.index_);
+    return iterator(this, pos.index_);
+  }
+
+  iterator find(const Key &key) { return iterator(this, find_index(key)); }
+  const_iterator find(const Key &key) const {
+    return const_iterator(this, find_index(key));
+  }
+  bool contains(const Key &key) const { return find_index(key) != size(); }
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  iterator lower_bound(const Key &key) {
+    return iterator(this, lower_bound_index(key));
+  }
+  const_iterator lower_bound(const Key &key) const {
+    return const_iterator(this, lower_bound_index(key));
+  }
+  iterator upper_bound(const Key &key) {
+    return iterator(this, upper_bound_index(key));
+  }
+  const_iterator upper_bound(const Key &key) const {
+    return const_iterator(this, upper_bound_index(key));
+  }
+
+  // 打印所有元素，形如 key:value
+  void printElements() const {
+    for (size_type i = 0; i < size(); ++i) {
+      std::cout << keys_[i] << ":" << values_[i] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  // 迭代器 interface
+  iterator begin() noexcept { return iterator(this, 0); }
+  iterator end() noexcept { return iterator(this, size()); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+private:
+  vector<Key> keys_;
+  vector<T> values_;
+  [[no_unique_address]] Compare comp_;
+
+  size_type lower_bound_index(const Key &key) const {
+    return static_cast<size_type>(
+        detail::branchless_lower_bound(keys_.data(), size(), key, comp_) -
+        keys_.data());
+  }
+  size_type upper_bound_index(const Key &key) const {
+    auto it = std::upper_bound(keys_.begin(), keys_.end(), key, comp_);
+    return static_cast<size_type>(it - keys_.begin());
+  }
+  size_type find_index(const Key &key) const {
+    return static_cast<size_type>(
+        detail::flat_find<LinearScanMax>(keys_.data(), size(), key, comp_) -
+        keys_.data());
+  }
+
+  // 返回键所在的下标和是否新插入；值构造失败时把刚插入的键撤掉
+  template <typename K, typename... Args>
+  std::pair<size_type, bool> try_emplace_index(K &&key, Args &&...args) {
+    size_type pos = lower_bound_index(key);
+    if (pos != size() && !comp_(key, keys_[pos])) {
+      return {pos, false};
+    }
+    keys_.insert(pos, std::forward<K>(key));
+    try {
+      values_.emplace(values_.cbegin() + static_cast<difference_type>(pos),
+                      std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.erase(keys_.cbegin() + static_cast<difference_type>(pos));
+      throw;
+    }
+    return {pos, true};
+  }
+
+  void erase_index(size_type pos) {
+    keys_.erase(keys_.cbegin() + static_cast<difference_type>(pos));
+    values_.erase(values_.cbegin() + static_cast<difference_type>(pos));
+  }
+};
+
+} // namespace my_stl
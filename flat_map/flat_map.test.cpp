@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flat_map.hpp"
+
+TEST_CASE("my_stl::branchless_lower_bound matches std::lower_bound") {
+  std::vector<int> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(i * 2);
+  }
+  std::less<int> comp;
+  for (std::size_t n = 0; n <= keys.size(); ++n) {
+    for (int key = -1; key <= 200; ++key) {
+      const int *expected =
+          std::lower_bound(keys.data(), keys.data() + n, key);
+      REQUIRE(my_stl::detail::branchless_lower_bound(keys.data(), n, key,
+                                                     comp) == expected);
+    }
+  }
+}
+
+TEST_CASE("my_stl::flat_map insert, lookup and erase") {
+  my_stl::flat_map<std::string, int> m{{"b", 2}, {"a", 1}, {"c", 3}};
+  REQUIRE(m.size() == 3);
+  REQUIRE(m.keys()[0] == "a");
+  REQUIRE(m.values()[2] == 3);
+
+  auto [it, inserted] = m.insert({"b", 20});
+  REQUIRE_FALSE(inserted);
+  REQUIRE(it->second == 2);
+
+  auto [it2, inserted2] = m.try_emplace("aa", 11);
+  REQUIRE(inserted2);
+  REQUIRE(it2->first == "aa");
+  REQUIRE(m.keys()[1] == "aa");
+
+  m["d"] = 4;
+  m["a"] += 100;
+  REQUIRE(m.at("a") == 101);
+  REQUIRE(m.at("d") == 4);
+  REQUIRE_THROWS_AS(m.at("zz"), std::out_of_range);
+
+  m.insert_or_assign("b", 22);
+  REQUIRE(m.at("b") == 22);
+
+  REQUIRE(m.contains("c"));
+  REQUIRE(m.count("x") == 0);
+  REQUIRE(m.find("x") == m.end());
+  REQUIRE(m.lower_bound("ab")->first == "b");
+  REQUIRE(m.upper_bound("b")->first == "c");
+
+  REQUIRE(m.erase("aa") == 1);
+  REQUIRE(m.erase("aa") == 0);
+  auto next = m.erase(m.find("b"));
+  REQUIRE(next->first == "c");
+
+  std::string joined;
+  for (auto [key, value] : m) {
+    joined += key + "=" + std::to_string(value) + ";";
+  }
+  REQUIRE(joined == "a=101;c=3;d=4;");
+}
+
+TEST_CASE("my_stl::flat_map bulk insert sorts and merges once") {
+  my_stl::flat_map<int, std::string> m{{5, "five"}, {1, "one"}};
+
+  std::vector<std::pair<int, std::string>> batch{
+      {3, "three"}, {5, "FIVE"}, {2, "two"}, {3, "THREE"}, {9, "nine"}};
+  m.insert(batch.begin(), batch.end());
+
+  REQUIRE(m.size() == 5);
+  // 已有的键保留原值，新元素之间重复时保留先出现的
+  REQUIRE(m.at(5) == "five");
+  REQUIRE(m.at(3) == "three");
+  int expected[] = {1, 2, 3, 5, 9};
+  for (std::size_t i = 0; i < 5; ++i) {
+    REQUIRE(m.keys()[i] == expected[i]);
+  }
+
+  const auto &cm = m;
+  REQUIRE(cm.find(9)->second == "nine");
+  REQUIRE(cm.end() - cm.begin() == 5);
+}
+
+TEST_CASE("my_stl::flat_map agrees with std::map on random operations") {
+  // 打开 SIMD 扫描：小规模时扫描，大了之后走二分
+  my_stl::flat_map<int, int, std::less<int>, 64> m;
+  std::map<int, int> ref;
+  std::mt19937 rng(1);
+  for (int step = 0; step < 3000; ++step) {
+    int key = static_cast<int>(rng() % 500);
+    switch (rng() % 3) {
+    case 0:
+      m[key] = step;
+      ref[key] = step;
+      break;
+    case 1:
+      REQUIRE(m.erase(key) == ref.erase(key));
+      break;
+    default:
+      REQUIRE(m.contains(key) == ref.contains(key));
+      if (ref.contains(key)) {
+        REQUIRE(m.at(key) == ref.at(key));
+      }
+    }
+  }
+  REQUIRE(m.size() == ref.size());
+  auto it = ref.begin();
+  for (auto [key, value] : m) {
+    REQUIRE(key == it->first);
+    REQUIRE(value == it->second);
+    ++it;
+  }
+}
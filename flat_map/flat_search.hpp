@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "vector/simd_algorithms.hpp"
+
+// flat_map / flat_set 共用的有序数组查找
+namespace my_stl::detail {
+
+// 无分支的 lower_bound：每轮只根据一次比较用条件传送移动 base，
+// 循环次数只和 n 有关，没有难以预测的分支
+template <typename K, typename Compare>
+const K *branchless_lower_bound(const K *first, std::size_t n, const K &key,
+                                const Compare &comp) {
+  if (n == 0) {
+    return first;
+  }
+  const K *base = first;
+  while (n > 1) {
+    std::size_t half = n / 2;
+    base = comp(base[half], key) ? base + half : base;
+    n -= half;
+  }
+  return base + (comp(*base, key) ? 1 : 0);
+}
+
+// 键是 int32/float/double 且按默认的 < 排序时，等值查找可以改用 SIMD 线性扫描
+template <typename K, typename Compare>
+inline constexpr bool simd_scannable =
+    simd::kernel_type<K> && (std::is_same_v<Compare, std::less<K>> ||
+                             std::is_same_v<Compare, std::less<>>);
+
+// 在有序的 [keys, keys + n) 里找与 key 等价的元素，找不到返回 keys + n。
+// n 不超过 LinearScanMax 时走 SIMD 扫描，小数组上比二分更快
+template <std::size_t LinearScanMax, typename K, typename Compare>
+const K *flat_find(const K *keys, std::size_t n, const K &key,
+                   const Compare &comp) {
+  if constexpr (LinearScanMax > 0 && simd_scannable<K, Compare>) {
+    if (n <= LinearScanMax) {
+      return simd::find(keys, keys + n, key);
+    }
+  }
+  const K *it = branchless_lower_bound(keys, n, key, comp);
+  return it != keys + n && !comp(key, *it) ? it : keys + n;
+}
+
+} // namespace my_stl::detail
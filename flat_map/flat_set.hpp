@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "flat_search.hpp"
+#include "vector/vector.hpp"
+
+namespace my_stl {
+
+// 有序 my_stl::vector 上的集合：元素连续存放，查找对缓存友好，
+// 适合读多写少的中小规模集合。单个 insert/erase 是 O(n) 的搬移，
+// 批量插入请用 insert(first, last)，只排序、合并一次。
+// LinearScanMax：元素不多于这个数时，等值查找改用 SIMD 线性扫描，默认关闭
+// （见 flat_map.bench）。
+template <typename Key, typename Compare = std::less<Key>,
+          std::size_t LinearScanMax = 0>
+class flat_set {
+public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_reference = const Key &;
+  // 元素不能原地修改，否则会破坏顺序
+  using iterator = typename vector<Key>::const_iterator;
+  using const_iterator = iterator;
+
+  flat_set() = default;
+  explicit flat_set(const Compare &comp) : comp_(comp) {}
+  flat_set(std::initializer_list<Key> ilist, const Compare &comp = Compare())
+      : comp_(comp) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  size_type size() const noexcept { return keys_.size(); }
+  bool empty() const noexcept { return keys_.empty(); }
+  void clear() noexcept { keys_.clear(); }
+  void reserve(size_type n) { keys_.reserve(n); }
+
+  const Key *data() const noexcept { return keys_.data(); }
+
+  // 插入单个元素，返回位置和是否真的插入了
+  std::pair<iterator, bool> insert(const Key &key) { return emplace(key); }
+  std::pair<iterator, bool> insert(Key &&key) {
+    return emplace(std::move(key));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    Key key(std::forward<Args>(args)...);
+    size_type pos = lower_bound_index(key);
+    if (pos != size() && !comp_(key, keys_[pos])) {
+      return {begin() + static_cast<difference_type>(pos), false};
+    }
+    keys_.insert(pos, std::move(key));
+    return {begin() + static_cast<difference_type>(pos), true};
+  }
+
+  // 批量插入：新元素追加到末尾、排序，再和原有部分合并一次并去重。
+  // 已有的元素优先，新元素之间重复时保留先出现的那个
+  template <std::input_iterator InputIt>
+  void insert(InputIt first, InputIt last) {
+    size_type old_size = keys_.size();
+    keys_.insert(keys_.cend(), first, last);
+
+    auto mid = keys_.begin() + static_cast<difference_type>(old_size);
+    std::stable_sort(mid, keys_.end(), comp_);
+    std::inplace_merge(keys_.begin(), mid, keys_.end(), comp_);
+    auto equivalent = [this](const Key &a, const Key &b) {
+      return !comp_(a, b) && !comp_(b, a);
+    };
+    auto new_end = std::unique(keys_.begin(), keys_.end(), equivalent);
+    keys_.erase(new_end, keys_.end());
+  }
+  void insert(std::initializer_list<Key> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // 删除与 key 等价的元素，返回删除的个数
+  size_type erase(const Key &key) {
+    const_iterator it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    keys_.erase(it);
+    return 1;
+  }
+  iterator erase(const_iterator pos) { return keys_.erase(pos); }
+
+  iterator find(const Key &key) const {
+    return iterator(
+        detail::flat_find<LinearScanMax>(keys_.data(), size(), key, comp_));
+  }
+  bool contains(const Key &key) const { return find(key) != end(); }
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  iterator lower_bound(const Key &key) const {
+    return begin() + static_cast<difference_type>(lower_bound_index(key));
+  }
+  iterator upper_bound(const Key &key) const {
+    return std::upper_bound(begin(), end(), key, comp_);
+  }
+
+  // 打印所有元素
+  void printElements() const { keys_.printElements(); }
+
+  // 迭代器 interface
+  iterator begin() const noexcept { return keys_.begin(); }
+  iterator end() const noexcept { return keys_.end(); }
+  iterator cbegin() const noexcept { return keys_.cbegin(); }
+  iterator cend() const noexcept { return keys_.cend(); }
+
+private:
+  vector<Key> keys_;
+  [[no_unique_address]] Compare comp_;
+
+  size_type lower_bound_index(const Key &key) const {
+    return static_cast<size_type>(
+        detail::branchless_lower_bound(keys_.data(), size(), key, comp_) -
+        keys_.data());
+  }
+};
+
+} // namespace my_stl
@@ -0,0 +1,48 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flat_set.hpp"
+
+TEST_CASE("my_stl::flat_set keeps unique sorted keys") {
+  my_stl::flat_set<int> s{5, 1, 3, 1, 5};
+  REQUIRE(s.size() == 3);
+  REQUIRE(*s.begin() == 1);
+
+  auto [it, inserted] = s.insert(2);
+  REQUIRE(inserted);
+  REQUIRE(*it == 2);
+  REQUIRE_FALSE(s.insert(3).second);
+
+  REQUIRE(s.contains(5));
+  REQUIRE_FALSE(s.contains(4));
+  REQUIRE(s.find(4) == s.end());
+  REQUIRE(*s.lower_bound(4) == 5);
+  REQUIRE(*s.upper_bound(2) == 3);
+
+  REQUIRE(s.erase(1) == 1);
+  REQUIRE(s.erase(1) == 0);
+  REQUIRE(s.size() == 3);
+  REQUIRE(s.data()[0] == 2);
+}
+
+TEST_CASE("my_stl::flat_set bulk insert and custom comparators") {
+  my_stl::flat_set<std::string, std::greater<>> s{"b", "d"};
+  std::vector<std::string> batch{"a", "e", "d", "c", "a"};
+  s.insert(batch.begin(), batch.end());
+
+  std::string joined;
+  for (const std::string &key : s) {
+    joined += key;
+  }
+  REQUIRE(joined == "edcba");
+
+  // 打开 SIMD 扫描后结果一样
+  my_stl::flat_set<double> plain{2.5, 0.5, 1.5};
+  my_stl::flat_set<double, std::less<double>, 16> scanned{2.5, 0.5, 1.5};
+  for (double key : {0.5, 1.0, 1.5, 2.5, 3.0}) {
+    REQUIRE(plain.contains(key) == scanned.contains(key));
+  }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace my_stl {
+
+// 容器的扩容策略。每个策略提供
+//   next_capacity(capacity, required)：放下 required 个元素时的新容量，
+//                                      结果不小于 required；
+//   claims_allocator_slack：为 true 时容器改用 malloc 分配，并把
+//                           malloc_usable_size 报告的尾部空闲也算进容量。
+
+// 每次翻倍（默认），均摊 O(1)，最多浪费一半内存
+struct grow_2x {
+  static constexpr bool claims_allocator_slack = false;
+
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required) noexcept {
+    return std::max(required, capacity == 0 ? std::size_t{1} : 2 * capacity);
+  }
+};
+
+// 每次增长一半，空闲最多三分之一，且释放的旧块有机会被后续扩容复用
+struct grow_1_5x {
+  static constexpr bool claims_allocator_slack = false;
+
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required) noexcept {
+    return std::max(required, capacity + capacity / 2 + 1);
+  }
+};
+
+// 按 1.5 倍增长，再把分配器 size class 向上取整多出来的字节收为容量。
+// 只有自己管理原始内存的容器（vector）能收回这部分空闲
+struct grow_size_class : grow_1_5x {
+  static constexpr bool claims_allocator_slack = true;
+};
+
+// 每次固定多 Step 个元素，内存最省但追加是 O(n^2 / Step)
+template <std::size_t Step> struct grow_fixed {
+  static_assert(Step > 0, "grow_fixed needs a positive step");
+
+  static constexpr bool claims_allocator_slack = false;
+
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required) noexcept {
+    return std::max(required, capacity + Step);
+  }
+};
+
+} // namespace my_stl
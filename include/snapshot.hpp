@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// 容器的二进制快照格式（vector::save/load、deque::save/load 共用）：
+//
+//   [0, 64)   snapshot_header
+//   [64, ...) count 个元素的原始字节，按逻辑顺序排列
+//
+// 只支持平凡可复制的元素，内容是本机字节序和本机的类型布局；
+// header 里的 type_size / type_align 用来挡住明显不匹配的类型。
+// 元素区从第 64 字节开始，所以 mapped_snapshot 可以直接把文件映射成 T 数组。
+namespace my_stl {
+
+template <typename T>
+concept snapshottable = std::is_trivially_copyable_v<T>;
+
+struct snapshot_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t type_size;
+  std::uint32_t type_align;
+  std::uint32_t reserved;
+  std::uint64_t count;
+  std::uint64_t checksum; // 元素区的 detail::checksum64
+  unsigned char padding[24];
+};
+static_assert(sizeof(snapshot_header) == 64);
+
+inline constexpr char snapshot_magic[8] = {'M', 'Y', 'S', 'T',
+                                           'L', 'S', 'N', 'P'};
+inline constexpr std::uint32_t snapshot_version = 1;
+
+namespace detail {
+
+// xxHash64 结构的校验和：4 路独立累加，每轮吃 32 字节，
+// 可以分段 update，结果只和拼起来的字节流有关
+class checksum64 {
+public:
+  void update(const void *data, std::size_t n) noexcept {
+    if (n == 0) {
+      return; // data 可能是空指针
+    }
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    total_ += n;
+    if (buffered_ != 0) {
+      std::size_t take = std::min(n, block - buffered_);
+      std::memcpy(buf_ + buffered_, p, take);
+      buffered_ += take;
+      p += take;
+      n -= take;
+      if (buffered_ < block) {
+        return;
+      }
+      round(buf_);
+      buffered_ = 0;
+    }
+    for (; n >= block; p += block, n -= block) {
+      round(p);
+    }
+    std::memcpy(buf_, p, n);
+    buffered_ = n;
+  }
+
+  std::uint64_t finish() const noexcept {
+    std::uint64_t h = std::rotl(lanes_[0], 1) + std::rotl(lanes_[1], 7) +
+                      std::rotl(lanes_[2], 12) + std::rotl(lanes_[3], 18);
+    h += total_ * prime1;
+    for (std::size_t i = 0; i < buffered_; ++i) {
+      h = std::rotl(h ^ (buf_[i] * prime3), 11) * prime1;
+    }
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+private:
+  static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+  static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+  static constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+  static constexpr std::size_t block = 32;
+
+  std::uint64_t lanes_[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+  std::uint64_t total_ = 0;
+  unsigned char buf_[block];
+  std::size_t buffered_ = 0;
+
+  void round(const unsigned char *p) noexcept {
+    for (int i = 0; i < 4; ++i) {
+      std::uint64_t word;
+      std::memcpy(&word, p + 8 * i, sizeof(word));
+      lanes_[i] = std::rotl(lanes_[i] + word * prime2, 31) * prime1;
+    }
+  }
+};
+
+[[noreturn]] inline void throw_snapshot_errno(const char *what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+template <typename T>
+snapshot_header make_snapshot_header(std::uint64_t count,
+                                     std::uint64_t checksum) noexcept {
+  snapshot_header h{};
+  std::memcpy(h.magic, snapshot_magic, sizeof(h.magic));
+  h.version = snapshot_version;
+  h.type_size = sizeof(T);
+  h.type_align = alignof(T);
+  h.count = count;
+  h.checksum = checksum;
+  return h;
+}
+
+template <typename T> void check_snapshot_header(const snapshot_header &h) {
+  if (std::memcmp(h.magic, snapshot_magic, sizeof(h.magic)) != 0) {
+    throw std::runtime_error("snapshot: bad magic");
+  }
+  if (h.version != snapshot_version) {
+    throw std::runtime_error("snapshot: unsupported version");
+  }
+  if (h.type_size != sizeof(T) || h.type_align != alignof(T)) {
+    throw std::runtime_error("snapshot: element type does not match");
+  }
+}
+
+// 写出若干段连续内存：ostream 逐段 write，fd 用一次 writev（处理部分写）
+inline void write_segments(std::ostream &out, const iovec *iov, int n) {
+  for (int i = 0; i < n; ++i) {
+    out.write(static_cast<const char *>(iov[i].iov_base),
+              static_cast<std::streamsize>(iov[i].iov_len));
+  }
+  if (!out) {
+    throw std::runtime_error("snapshot: write failed");
+  }
+}
+inline void write_segments(int fd, iovec *iov, int n) {
+  while (n > 0) {
+    ssize_t written = ::writev(fd, iov, std::min(n, IOV_MAX));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_snapshot_errno("snapshot: writev");
+    }
+    auto left = static_cast<std::size_t>(written);
+    while (n > 0 && left >= iov->iov_len) {
+      left -= iov->iov_len;
+      ++iov;
+      --n;
+    }
+    if (n > 0) {
+      iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+      iov->iov_len -= left;
+    }
+  }
+}
+
+inline void read_bytes(std::istream &in, void *dest, std::size_t n) {
+  in.read(static_cast<char *>(dest), static_cast<std::streamsize>(n));
+  if (static_cast<std::size_t>(in.gcount()) != n) {
+    throw std::runtime_error("snapshot: unexpected end of input");
+  }
+}
+inline void read_bytes(int fd, void *dest, std::size_t n) {
+  char *p = static_cast<char *>(dest);
+  while (n > 0) {
+    ssize_t got = ::read(fd, p, n);
+    if (got < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_snapshot_errno("snapshot: read");
+    }
+    if (got == 0) {
+      throw std::runtime_error("snapshot: unexpected end of input");
+    }
+    p += got;
+    n -= static_cast<std::size_t>(got);
+  }
+}
+
+// 输入里还剩多少字节；流不可定位（管道、socket）时返回 SIZE_MAX，
+// 只能靠后面的读取失败发现截断
+inline std::size_t remaining_bytes(std::istream &in) {
+  std::istream::pos_type here = in.tellg();
+  if (here == std::istream::pos_type(-1)) {
+    in.clear();
+    return SIZE_MAX;
+  }
+  in.seekg(0, std::ios::end);
+  std::istream::pos_type end = in.tellg();
+  in.seekg(here);
+  if (!in || end == std::istream::pos_type(-1) || end < here) {
+    in.clear();
+    in.seekg(here);
+    return SIZE_MAX;
+  }
+  return static_cast<std::size_t>(end - here);
+}
+inline std::size_t remaining_bytes(int fd) {
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    return SIZE_MAX;
+  }
+  off_t here = ::lseek(fd, 0, SEEK_CUR);
+  if (here < 0 || here > st.st_size) {
+    return SIZE_MAX;
+  }
+  return static_cast<std::size_t>(st.st_size - here);
+}
+
+// 把 iov[1, n] 这 n 段元素字节当成一个序列写成快照；iov[0] 留给 header
+template <typename T, typename Sink>
+void save_snapshot_segments(Sink &&sink, iovec *iov, int n) {
+  checksum64 sum;
+  std::size_t bytes = 0;
+  for (int i = 1; i <= n; ++i) {
+    sum.update(iov[i].iov_base, iov[i].iov_len);
+    bytes += iov[i].iov_len;
+  }
+  snapshot_header header =
+      make_snapshot_header<T>(bytes / sizeof(T), sum.finish());
+  iov[0] = {&header, sizeof(header)};
+  write_segments(sink, iov, n + 1);
+}
+
+// 把 [a, a + na) 和 [b, b + nb) 两段当成一个序列写成快照
+template <typename T, typename Sink>
+void save_snapshot(Sink &&sink, const T *a, std::size_t na, const T *b,
+                   std::size_t nb) {
+  iovec iov[3] = {{nullptr, 0},
+                  {const_cast<T *>(a), na * sizeof(T)},
+                  {const_cast<T *>(b), nb * sizeof(T)}};
+  save_snapshot_segments<T>(sink, iov, nb == 0 ? 1 : 2);
+}
+
+// 读 header，调用 storage(count) 拿到能放下 count 个元素的缓冲区，
+// 元素字节直接读进去再校验
+template <typename T, typename Source, typename Storage>
+void load_snapshot(Source &&source, Storage storage) {
+  snapshot_header header;
+  read_bytes(source, &header, sizeof(header));
+  check_snapshot_header<T>(header);
+
+  // count 来自文件，分配之前先确认剩下的字节放得下，
+  // 同时保证 count * sizeof(T) 不会溢出
+  if (header.count > remaining_bytes(source) / sizeof(T)) {
+    throw std::runtime_error("snapshot: checksum mismatch");
+  }
+  std::size_t count = static_cast<std::size_t>(header.count);
+  T *dest = storage(count);
+  read_bytes(source, dest, count * sizeof(T));
+
+  checksum64 sum;
+  sum.update(dest, count * sizeof(T));
+  if (sum.finish() != header.checksum) {
+    throw std::runtime_error("snapshot: checksum mismatch");
+  }
+}
+
+} // namespace detail
+
+// 只读地把快照文件映射到内存，不拷贝；页面在第一次访问时才读入。
+// 构造时只检查 header，需要校验元素内容时调用 verify()（会读遍整个文件）
+template <snapshottable T> class mapped_snapshot {
+  static_assert(alignof(T) <= sizeof(snapshot_header),
+                "elements are stored at a 64 byte offset");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_pointer = const T *;
+  using const_iterator = const T *;
+
+  explicit mapped_snapshot(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      detail::throw_snapshot_errno("snapshot: open");
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      int err = errno;
+      ::close(fd);
+      errno = err;
+      detail::throw_snapshot_errno("snapshot: fstat");
+    }
+    bytes_ = static_cast<std::size_t>(st.st_size);
+    if (bytes_ < sizeof(snapshot_header)) {
+      ::close(fd);
+      throw std::runtime_error("snapshot: file too short");
+    }
+    base_ = ::mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // 映射建立后不再需要 fd
+    if (base_ == MAP_FAILED) {
+      base_ = nullptr;
+      detail::throw_snapshot_errno("snapshot: mmap");
+    }
+
+    try {
+      detail::check_snapshot_header<T>(header());
+      if (header().count > (bytes_ - sizeof(snapshot_header)) / sizeof(T)) {
+        throw std::runtime_error("snapshot: file too short");
+      }
+    } catch (...) {
+      ::munmap(base_, bytes_);
+      throw;
+    }
+  }
+
+  ~mapped_snapshot() {
+    if (base_ != nullptr) {
+      ::munmap(base_, bytes_);
+    }
+  }
+
+  mapped_snapshot(const mapped_snapshot &) = delete;
+  mapped_snapshot &operator=(const mapped_snapshot &) = delete;
+
+  mapped_snapshot(mapped_snapshot &&other) noexcept
+      : base_(std::exchange(other.base_, nullptr)),
+        bytes_(std::exchange(other.bytes_, 0)) {}
+  mapped_snapshot &operator=(mapped_snapshot &&other) noexcept {
+    if (this != &other) {
+      if (base_ != nullptr) {
+        ::munmap(base_, bytes_);
+      }
+      base_ = std::exchange(other.base_, nullptr);
+      bytes_ = std::exchange(other.bytes_, 0);
+    }
+    return *this;
+  }
+
+  const T &operator[](size_type pos) const noexcept { return data()[pos]; }
+
+  const_pointer data() const noexcept {
+    return reinterpret_cast<const T *>(static_cast<const char *>(base_) +
+                                       sizeof(snapshot_header));
+  }
+  size_type size() const noexcept {
+    return static_cast<size_type>(header().count);
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  const_iterator begin() const noexcept { return data(); }
+  const_iterator end() const noexcept { return data() + size(); }
+
+  // 重新计算校验和并与 header 比较
+  bool verify() const noexcept {
+    detail::checksum64 sum;
+    sum.update(data(), size() * sizeof(T));
+    return sum.finish() == header().checksum;
+  }
+
+private:
+  void *base_ = nullptr;
+  std::size_t bytes_ = 0;
+
+  const snapshot_header &header() const noexcept {
+    return *static_cast<const snapshot_header *>(base_);
+  }
+};
+
+} // namespace my_stl
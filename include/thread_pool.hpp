@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "deque/deque.h"
+#include "vector/vector.hpp"
+
+namespace my_stl {
+
+// 简单的 work-stealing 线程池。
+// 每个线程有自己的任务队列（my_stl::deque）：自己从尾部取（LIFO，缓存友好），
+// 空闲线程从别人头部偷（FIFO，偷到的通常是更大的任务块）。
+// 线程池外的线程提交的任务放进 0 号队列；调用 task_group::wait 的线程
+// 也会帮忙执行任务，所以 thread_pool(n) 只启动 n - 1 个后台线程。
+class thread_pool {
+public:
+  explicit thread_pool(std::size_t concurrency = default_concurrency())
+      : queue_count_(std::max<std::size_t>(concurrency, 1)),
+        queues_(std::make_unique<worker_queue[]>(queue_count_)) {
+    for (std::size_t i = 1; i < queue_count_; ++i) {
+      workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  // 等队列里剩下的任务跑完再退出
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &t : workers_) {
+      t.join();
+    }
+  }
+
+  // 并行度：后台线程数 + 1 个调用方线程
+  std::size_t concurrency() const noexcept { return queue_count_; }
+
+  // 提交一个任务，不等待结果；任务本身不能抛异常，需要异常请用 task_group
+  template <typename F> void submit(F &&task) {
+    std::function<void()> fn(std::forward<F>(task));
+    {
+      // 先计数再入队，空闲线程被唤醒后最多短暂地多转几圈
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      ++pending_;
+    }
+    worker_queue &q = queues_[own_index()];
+    {
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.tasks.push_back(std::move(fn));
+    }
+    wake_.notify_one();
+  }
+
+  // 在当前线程上执行一个待办任务；没有任务时返回 false
+  bool try_run_one() {
+    std::function<void()> task;
+    if (!pop_task(own_index(), task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+  static std::size_t default_concurrency() noexcept {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // 进程内共享的默认线程池，并行度为 hardware_concurrency
+  static thread_pool &default_pool() {
+    static thread_pool pool;
+    return pool;
+  }
+
+private:
+  struct worker_queue {
+    std::mutex mutex;
+    deque<std::function<void()>> tasks;
+  };
+
+  std::size_t queue_count_;
+  std::unique_ptr<worker_queue[]> queues_;
+  vector<std::thread> workers_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::size_t> pending_{0};
+  bool stop_{false};
+
+  // 当前线程在哪个线程池里、用哪个队列
+  static inline thread_local const thread_pool *tls_pool_ = nullptr;
+  static inline thread_local std::size_t tls_index_ = 0;
+
+  std::size_t own_index() const noexcept {
+    return tls_pool_ == this ? tls_index_ : 0;
+  }
+
+  // 先取自己队列的尾部，再依次偷其他队列的头部
+  bool pop_task(std::size_t self, std::function<void()> &task) {
+    {
+      worker_queue &q = queues_[self];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.tasks.empty()) {
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    for (std::size_t k = 1; k < queue_count_; ++k) {
+      worker_queue &q = queues_[(self + k) % queue_count_];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.tasks.empty()) {
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void worker_loop(std::size_t index) {
+    tls_pool_ = this;
+    tls_index_ = index;
+
+    std::function<void()> task;
+    while (true) {
+      if (pop_task(index, task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_.wait(lock, [this] { return stop_ || pending_.load() != 0; });
+      if (stop_ && pending_.load() == 0) {
+        return;
+      }
+    }
+  }
+};
+
+// 一组 fork-join 任务：run 提交，wait 等全部完成。
+// wait 期间当前线程会执行池里的任务，所以在任务里再嵌套 task_group 也不会死锁。
+// 任务抛出的第一个异常会在 wait 中重新抛出。
+class task_group {
+public:
+  explicit task_group(thread_pool &pool) noexcept : pool_(pool) {}
+
+  task_group(const task_group &) = delete;
+  task_group &operator=(const task_group &) = delete;
+
+  ~task_group() {
+    try {
+      wait();
+    } catch (...) {
+    }
+  }
+
+  template <typename F> void run(F &&f) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.submit([this, f = std::forward<F>(f)]() mutable {
+      try {
+        f();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+      pending_.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  void wait() {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+      if (!pool_.try_run_one()) {
+        std::this_thread::yield();
+      }
+    }
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+private:
+  thread_pool &pool_;
+  std::atomic<std::size_t> pending_{0};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+} // namespace my_stl
@@ -0,0 +1,101 @@
+#include "dynamic_bitset.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// 按字节存的 vector<bool> 和按位压缩的 dynamic_bitset 对比：
+// 内存占用、count、按位与的吞吐以及稀疏集合上的 find_next 遍历
+
+namespace {
+
+constexpr std::size_t kBits = 64'000'000;
+constexpr int kRepeats = 10;
+
+template <typename F> double time_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRepeats; ++r) {
+    f();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count() /
+         kRepeats;
+}
+
+} // namespace
+
+int main() {
+  my_stl::vector<bool> bytes;
+  bytes.reserve(kBits);
+  my_stl::dynamic_bitset a(kBits);
+  my_stl::dynamic_bitset b(kBits);
+  for (std::size_t i = 0; i < kBits; ++i) {
+    bool bit = (i * 2654435761u) % 7 < 3;
+    bytes.push_back(bit);
+    a[i] = bit;
+    b[i] = i % 5 != 0;
+  }
+
+  volatile std::size_t sink = 0;
+  std::printf("%zu flags: vector<bool> %zu KiB, dynamic_bitset %zu KiB\n",
+              kBits, bytes.size() / 1024,
+              a.words().size() * sizeof(std::uint64_t) / 1024);
+
+  double bytes_count = time_ms([&] {
+    sink = static_cast<std::size_t>(
+        std::count(bytes.begin(), bytes.end(), true));
+  });
+  double bits_count = time_ms([&] { sink = a.count(); });
+  std::printf("count        vector<bool> %7.2f ms  bitset %7.2f ms (%.1fx)\n",
+              bytes_count, bits_count, bytes_count / bits_count);
+
+  // 逐字节的 && 和按字（AVX2 时每次 256 位）的 &= 对比
+  my_stl::vector<bool> bytes_b;
+  bytes_b.reserve(kBits);
+  for (std::size_t i = 0; i < kBits; ++i) {
+    bytes_b.push_back(b[i]);
+  }
+  double bytes_and = time_ms([&] {
+    for (std::size_t i = 0; i < kBits; ++i) {
+      bytes[i] = bytes[i] && bytes_b[i];
+    }
+    sink = bytes[0];
+  });
+  double bits_and = time_ms([&] {
+    a &= b;
+    sink = a.words()[0];
+  });
+  // 每次读两个字数组、写一个字数组
+  double bits_moved = 3.0 * static_cast<double>(a.words().size()) * 8;
+  std::printf("a &= b       vector<bool> %7.2f ms  bitset %7.2f ms (%.1fx, "
+              "%.1f GB/s)\n",
+              bytes_and, bits_and, bytes_and / bits_and,
+              bits_moved / bits_and / 1e6);
+
+  my_stl::dynamic_bitset sparse(kBits);
+  for (std::size_t i = 0; i < kBits; i += 4099) {
+    sparse.set(i);
+  }
+  double scan_bytes = time_ms([&] {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < kBits; ++i) {
+      n += sparse[i] ? 1 : 0;
+    }
+    sink = n;
+  });
+  double scan_words = time_ms([&] {
+    std::size_t n = 0;
+    for (std::size_t pos = sparse.find_first(); pos != sparse.npos;
+         pos = sparse.find_next(pos)) {
+      ++n;
+    }
+    sink = n;
+  });
+  std::printf("sparse walk  operator[] %7.2f ms  find_next %7.2f ms "
+              "(%.1fx)\n",
+              scan_bytes, scan_words, scan_bytes / scan_words);
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include "cow_vector.hpp"
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// 把大数组的快照交给读者：深拷贝 my_stl::vector 和共享缓冲区的 cow_vector
+
+namespace {
+
+constexpr std::size_t kCount = 8'000'000;
+constexpr int kSnapshots = 16;
+
+template <typename F> double time_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+} // namespace
+
+int main() {
+  my_stl::vector<int> items;
+  items.reserve(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    items.push_back(static_cast<int>(i));
+  }
+  my_stl::cow_vector<int> shared(items);
+
+  volatile std::size_t sink = 0;
+  double deep = time_ms([&] {
+    for (int s = 0; s < kSnapshots; ++s) {
+      my_stl::vector<int> copy(items);
+      sink = copy.size();
+    }
+  });
+  double cow = time_ms([&] {
+    for (int s = 0; s < kSnapshots; ++s) {
+      my_stl::cow_vector<int> copy(shared);
+      sink = copy.size();
+    }
+  });
+  std::printf("%d snapshots of %zu ints: vector %8.3f ms  cow_vector %8.3f "
+              "ms\n",
+              kSnapshots, kCount, deep, cow);
+
+  // 有快照存在时的第一次写入要复制一次，之后的写入不再复制
+  my_stl::cow_vector<int> reader = shared;
+  double first_write = time_ms([&] { shared[0] = -1; });
+  double second_write = time_ms([&] { shared[1] = -1; });
+  sink = reader.size();
+  std::printf("write while shared %8.3f ms  after detach %8.5f ms\n",
+              first_write, second_write);
+  return 0;
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace my_stl {
+
+// 写时复制（copy-on-write）的数组：拷贝只复制一个指针并把引用计数加一，
+// 多个 cow_vector 共享同一块 my_stl::vector，直到其中一个要修改它。
+// 适合把大数组的只读快照交给很多读线程：每个快照 O(1)，
+// 之后写者第一次修改时才真正复制一次。
+//
+// 会脱离共享（共享时先复制一份）的操作：
+//   非 const 的 operator[] / at / front / back / data / begin / end，
+//   push_back、emplace_back、pop_back、insert、emplace、erase、
+//   reserve、resize、shrink_to_fit。
+// 不复制的操作：所有 const 访问、拷贝、移动、swap；
+//   clear 和赋值在共享时只是放弃自己的那份引用。
+//
+// 线程安全性和 std::shared_ptr 相同：不同的 cow_vector 对象即使共享
+// 缓冲区，也可以在不同线程里各自读写；同一个对象被多个线程同时访问时，
+// 只能都是 const 的。
+// 非 const 访问拿到的引用和迭代器，在这个对象被拷贝之后不能再用来写，
+// 否则会改到快照里的内容。
+template <typename T> class cow_vector {
+  struct shared_buffer {
+    std::atomic<std::size_t> refs{1};
+    vector<T> items;
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = typename vector<T>::iterator;
+  using const_iterator = typename vector<T>::const_iterator;
+
+  cow_vector() noexcept : buffer_(nullptr) {}
+  cow_vector(std::initializer_list<T> ilist) : buffer_(new shared_buffer) {
+    buffer_->items.assign(ilist);
+  }
+  explicit cow_vector(const vector<T> &items) : buffer_(new shared_buffer) {
+    buffer_->items = items;
+  }
+  explicit cow_vector(vector<T> &&items) : buffer_(new shared_buffer) {
+    buffer_->items = std::move(items);
+  }
+
+  ~cow_vector() { release(); }
+
+  // 拷贝只共享缓冲区，O(1)
+  cow_vector(const cow_vector &other) noexcept : buffer_(other.buffer_) {
+    if (buffer_) {
+      buffer_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  cow_vector &operator=(const cow_vector &other) noexcept {
+    cow_vector tmp(other);
+    swap(tmp);
+    return *this;
+  }
+
+  cow_vector(cow_vector &&other) noexcept
+      : buffer_(std::exchange(other.buffer_, nullptr)) {}
+  cow_vector &operator=(cow_vector &&other) noexcept {
+    cow_vector tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+
+  void swap(cow_vector &other) noexcept { std::swap(buffer_, other.buffer_); }
+
+  // 共享同一缓冲区的 cow_vector 个数，空数组为 0
+  size_type use_count() const noexcept {
+    return buffer_ ? buffer_->refs.load(std::memory_order_acquire) : 0;
+  }
+  bool is_shared() const noexcept { return use_count() > 1; }
+
+  // 只读访问，不会复制
+  const T &operator[](size_type pos) const { return buffer_->items[pos]; }
+  const T &at(size_type pos) const {
+    if (pos >= size())
+      throw std::out_of_range("cow_vector::at out of range");
+    return buffer_->items[pos];
+  }
+  const T &front() const {
+    if (empty())
+      throw std::out_of_range("cow_vector::front on empty vector");
+    return buffer_->items.front();
+  }
+  const T &back() const {
+    if (empty())
+      throw std::out_of_range("cow_vector::back on empty vector");
+    return buffer_->items.back();
+  }
+  const T *data() const noexcept {
+    return buffer_ ? buffer_->items.data() : nullptr;
+  }
+
+  // 可写访问，共享时先复制
+  T &operator[](size_type pos) { return mutable_items()[pos]; }
+  T &at(size_type pos) {
+    if (pos >= size())
+      throw std::out_of_range("cow_vector::at out of range");
+    return mutable_items()[pos];
+  }
+  T &front() {
+    if (empty())
+      throw std::out_of_range("cow_vector::front on empty vector");
+    return mutable_items().front();
+  }
+  T &back() {
+    if (empty())
+      throw std::out_of_range("cow_vector::back on empty vector");
+    return mutable_items().back();
+  }
+  T *data() { return buffer_ ? mutable_items().data() : nullptr; }
+
+  size_type size() const noexcept {
+    return buffer_ ? buffer_->items.size() : 0;
+  }
+  size_type capacity() const noexcept {
+    return buffer_ ? buffer_->items.capacity() : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    cow_vector keep = keep_alive();
+    return mutable_items().emplace_back(std::forward<Args>(args)...);
+  }
+
+  void pop_back() {
+    if (!empty()) {
+      mutable_items().pop_back();
+    }
+  }
+
+  // pos 可以来自复制前的缓冲区，先换算成下标再复制
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    difference_type index = pos - cbegin();
+    cow_vector keep = keep_alive();
+    vector<T> &items = mutable_items();
+    return items.emplace(items.cbegin() + index, std::forward<Args>(args)...);
+  }
+  iterator insert(const_iterator pos, const T &value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+  }
+  template <std::input_iterator InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    difference_type index = pos - cbegin();
+    vector<T> &items = mutable_items();
+    return items.insert(items.cbegin() + index, first, last);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    difference_type index = first - cbegin();
+    difference_type count = last - first;
+    vector<T> &items = mutable_items();
+    auto it = items.cbegin() + index;
+    return items.erase(it, it + count);
+  }
+
+  // 共享时只放弃自己的引用，不复制
+  void clear() noexcept {
+    if (is_shared()) {
+      release();
+    } else if (buffer_) {
+      buffer_->items.clear();
+    }
+  }
+
+  void reserve(size_type new_cap) { mutable_items().reserve(new_cap); }
+  void resize(size_type count) { mutable_items().resize(count); }
+  void resize(size_type count, const T &value) {
+    cow_vector keep = keep_alive();
+    mutable_items().resize(count, value);
+  }
+  void shrink_to_fit() {
+    if (buffer_) {
+      mutable_items().shrink_to_fit();
+    }
+  }
+
+  // 打印数组中的元素
+  void printElements() const {
+    if (buffer_) {
+      buffer_->items.printElements();
+    } else {
+      std::cout << std::endl;
+    }
+  }
+
+  // 迭代器 interface：非 const 版本会先复制
+  iterator begin() { return buffer_ ? mutable_items().begin() : iterator(); }
+  iterator end() { return buffer_ ? mutable_items().end() : iterator(); }
+
+  const_iterator begin() const noexcept { return const_iterator(data()); }
+  const_iterator end() const noexcept {
+    return const_iterator(data() + size());
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  friend bool operator==(const cow_vector &lhs, const cow_vector &rhs) {
+    return lhs.buffer_ == rhs.buffer_ ||
+           std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+private:
+  shared_buffer *buffer_;
+
+  void release() noexcept {
+    if (buffer_ &&
+        buffer_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete buffer_;
+    }
+    buffer_ = nullptr;
+  }
+
+  // 参数可能引用共享缓冲区里的元素：共享时先多持有一份引用，
+  // 防止复制后别的快照同时释放，让旧缓冲区在这次修改结束前一直有效
+  cow_vector keep_alive() const noexcept {
+    return is_shared() ? *this : cow_vector();
+  }
+
+  // 保证缓冲区只属于自己：没有就新建，共享就复制一份。
+  // 引用计数为 1 时别的线程不可能再增加它（那需要先拿到本对象的拷贝），
+  // 所以检查之后可以放心原地修改
+  vector<T> &mutable_items() {
+    if (!buffer_) {
+      buffer_ = new shared_buffer;
+    } else if (buffer_->refs.load(std::memory_order_acquire) != 1) {
+      auto *copy = new shared_buffer;
+      try {
+        copy->items = buffer_->items;
+      } catch (...) {
+        delete copy;
+        throw;
+      }
+      release();
+      buffer_ = copy;
+    }
+    return buffer_->items;
+  }
+};
+
+} // namespace my_stl
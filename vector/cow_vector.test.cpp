@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "cow_vector.hpp"
+#include "vector.hpp"
+
+TEST_CASE("my_stl::cow_vector copies share the buffer until a write") {
+  my_stl::cow_vector<int> v{1, 2, 3};
+  REQUIRE(v.use_count() == 1);
+
+  my_stl::cow_vector<int> snapshot = v;
+  REQUIRE(v.use_count() == 2);
+  REQUIRE(std::as_const(snapshot).data() == std::as_const(v).data());
+
+  // const 访问不会复制
+  const auto &cv = v;
+  REQUIRE(cv[1] == 2);
+  REQUIRE(cv.at(2) == 3);
+  REQUIRE(cv.front() == 1);
+  REQUIRE(v.is_shared());
+
+  v[0] = 10;
+  REQUIRE_FALSE(v.is_shared());
+  REQUIRE(snapshot.use_count() == 1);
+  REQUIRE(v[0] == 10);
+  REQUIRE(snapshot[0] == 1);
+
+  // 已经独占时写入不再复制
+  const int *before = cv.data();
+  v[1] = 20;
+  REQUIRE(cv.data() == before);
+  REQUIRE_THROWS_AS(v.at(3), std::out_of_range);
+}
+
+TEST_CASE("my_stl::cow_vector every mutating call detaches") {
+  my_stl::cow_vector<std::string> original{"a", "b", "c"};
+
+  auto detaches = [&](auto mutate) {
+    my_stl::cow_vector<std::string> v = original;
+    mutate(v);
+    REQUIRE(original.use_count() == 1);
+    REQUIRE(original == my_stl::cow_vector<std::string>{"a", "b", "c"});
+  };
+
+  detaches([](auto &v) { v.push_back("d"); });
+  detaches([](auto &v) { v.emplace_back(3, 'x'); });
+  detaches([](auto &v) { v.pop_back(); });
+  detaches([](auto &v) { v.insert(v.cbegin() + 1, "z"); });
+  detaches([](auto &v) { v.erase(v.cbegin()); });
+  detaches([](auto &v) { v.back() = "q"; });
+  detaches([](auto &v) { *v.begin() = "q"; });
+  detaches([](auto &v) { v.resize(1); });
+  detaches([](auto &v) { v.reserve(100); });
+
+  my_stl::cow_vector<std::string> v = original;
+  v.insert(v.cbegin() + 1, "z");
+  v.erase(v.cbegin() + 2);
+  REQUIRE(v == my_stl::cow_vector<std::string>{"a", "z", "c"});
+
+  // 共享时 clear 只放弃引用
+  my_stl::cow_vector<std::string> cleared = original;
+  cleared.clear();
+  REQUIRE(cleared.empty());
+  REQUIRE(original.size() == 3);
+}
+
+TEST_CASE("my_stl::cow_vector push_back of its own shared element") {
+  my_stl::cow_vector<std::string> v{std::string(40, 'a')};
+  {
+    my_stl::cow_vector<std::string> snapshot = v;
+    v.push_back(std::as_const(v)[0]);
+  }
+  REQUIRE(v.size() == 2);
+  REQUIRE(v[1] == std::string(40, 'a'));
+}
+
+TEST_CASE("my_stl::cow_vector snapshots are safe to read across threads") {
+  my_stl::vector<int> items;
+  for (int i = 0; i < 10000; ++i) {
+    items.push_back(i);
+  }
+  my_stl::cow_vector<int> writer(std::move(items));
+
+  std::atomic<bool> ok{true};
+  my_stl::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([snapshot = writer, &ok] {
+      long long sum = 0;
+      for (int round = 0; round < 20; ++round) {
+        sum = 0;
+        for (int x : snapshot) {
+          sum += x;
+        }
+      }
+      if (sum != 49995000) {
+        ok = false;
+      }
+    });
+  }
+  // 写者修改时读者各自还持有旧快照
+  for (std::size_t i = 0; i < writer.size(); ++i) {
+    writer[i] = -1;
+  }
+  for (std::thread &t : readers) {
+    t.join();
+  }
+  REQUIRE(ok);
+  REQUIRE(writer.use_count() == 1);
+  REQUIRE(writer[9999] == -1);
+}
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "simd_algorithms.hpp"
+#include "vector.hpp"
+
+namespace my_stl {
+
+namespace detail::bit_kernels {
+
+enum class bit_op { and_, or_, xor_, and_not };
+
+template <bit_op Op>
+constexpr std::uint64_t combine(std::uint64_t a, std::uint64_t b) noexcept {
+  if constexpr (Op == bit_op::and_) {
+    return a & b;
+  } else if constexpr (Op == bit_op::or_) {
+    return a | b;
+  } else if constexpr (Op == bit_op::xor_) {
+    return a ^ b;
+  } else {
+    return a & ~b;
+  }
+}
+
+namespace scalar {
+
+template <bit_op Op>
+void apply(std::uint64_t *dst, const std::uint64_t *src,
+           std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = combine<Op>(dst[i], src[i]);
+  }
+}
+
+inline std::size_t popcount(const std::uint64_t *words,
+                            std::size_t n) noexcept {
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    total += static_cast<std::size_t>(std::popcount(words[i]));
+  }
+  return total;
+}
+
+} // namespace scalar
+
+#if MY_STL_SIMD_X86
+
+// ===== AVX2：每次处理 4 个字；popcount 用硬件 popcnt =====
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,popcnt"))),          \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+#endif
+
+namespace avx2 {
+
+template <bit_op Op>
+void apply(std::uint64_t *dst, const std::uint64_t *src,
+           std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i r;
+    if constexpr (Op == bit_op::and_) {
+      r = _mm256_and_si256(a, b);
+    } else if constexpr (Op == bit_op::or_) {
+      r = _mm256_or_si256(a, b);
+    } else if constexpr (Op == bit_op::xor_) {
+      r = _mm256_xor_si256(a, b);
+    } else {
+      r = _mm256_andnot_si256(b, a); // ~b & a
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), r);
+  }
+  for (; i < n; ++i) {
+    dst[i] = combine<Op>(dst[i], src[i]);
+  }
+}
+
+// 四个独立的累加器，让多条 popcnt 并行执行
+inline std::size_t popcount(const std::uint64_t *words,
+                            std::size_t n) noexcept {
+  std::uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    c0 += static_cast<std::uint64_t>(__builtin_popcountll(words[i]));
+    c1 += static_cast<std::uint64_t>(__builtin_popcountll(words[i + 1]));
+    c2 += static_cast<std::uint64_t>(__builtin_popcountll(words[i + 2]));
+    c3 += static_cast<std::uint64_t>(__builtin_popcountll(words[i + 3]));
+  }
+  for (; i < n; ++i) {
+    c0 += static_cast<std::uint64_t>(__builtin_popcountll(words[i]));
+  }
+  return static_cast<std::size_t>(c0 + c1 + c2 + c3);
+}
+
+} // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif // MY_STL_SIMD_X86
+
+template <bit_op Op>
+void apply(std::uint64_t *dst, const std::uint64_t *src,
+           std::size_t n) noexcept {
+#if MY_STL_SIMD_X86
+  if (simd::detected_isa() == simd::isa::avx2) {
+    return avx2::apply<Op>(dst, src, n);
+  }
+#endif
+  scalar::apply<Op>(dst, src, n);
+}
+
+inline std::size_t popcount(const std::uint64_t *words,
+                            std::size_t n) noexcept {
+#if MY_STL_SIMD_X86
+  if (simd::detected_isa() == simd::isa::avx2) {
+    return avx2::popcount(words, n);
+  }
+#endif
+  return scalar::popcount(words, n);
+}
+
+} // namespace detail::bit_kernels
+
+// 按位压缩的布尔数组：每个 64 位字存 64 个标志，内存只有 vector<bool>
+// （每个标志 1 字节）的 1/8。
+// 最后一个字中超出 size() 的位始终保持为 0，count / find / == 都依赖这一点。
+// 与、或、异或、与非按字批量计算，支持 AVX2 时一次处理 256 位。
+class dynamic_bitset {
+public:
+  using word_type = std::uint64_t;
+  using size_type = std::size_t;
+
+  static constexpr size_type bits_per_word = 64;
+  static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+  // 指向单个位的代理引用
+  class reference {
+    friend class dynamic_bitset;
+
+  public:
+    reference &operator=(bool value) noexcept {
+      if (value) {
+        *word_ |= mask_;
+      } else {
+        *word_ &= ~mask_;
+      }
+      return *this;
+    }
+    reference &operator=(const reference &other) noexcept {
+      return *this = static_cast<bool>(other);
+    }
+    operator bool() const noexcept { return (*word_ & mask_) != 0; }
+    bool operator~() const noexcept { return (*word_ & mask_) == 0; }
+    reference &flip() noexcept {
+      *word_ ^= mask_;
+      return *this;
+    }
+
+  private:
+    word_type *word_;
+    word_type mask_;
+
+    reference(word_type *word, word_type mask) noexcept
+        : word_(word), mask_(mask) {}
+  };
+
+  dynamic_bitset() = default;
+  explicit dynamic_bitset(size_type count, bool value = false) {
+    resize(count, value);
+  }
+
+  reference operator[](size_type pos) noexcept {
+    return reference(&words_[pos / bits_per_word], bit_mask(pos));
+  }
+  bool operator[](size_type pos) const noexcept {
+    return (words_[pos / bits_per_word] & bit_mask(pos)) != 0;
+  }
+
+  // 带边界检查的读取
+  bool test(size_type pos) const {
+    if (pos >= size_)
+      throw std::out_of_range("dynamic_bitset::test out of range");
+    return (*this)[pos];
+  }
+
+  dynamic_bitset &set(size_type pos, bool value = true) {
+    if (pos >= size_)
+      throw std::out_of_range("dynamic_bitset::set out of range");
+    (*this)[pos] = value;
+    return *this;
+  }
+  dynamic_bitset &reset(size_type pos) { return set(pos, false); }
+  dynamic_bitset &flip(size_type pos) {
+    if (pos >= size_)
+      throw std::out_of_range("dynamic_bitset::flip out of range");
+    (*this)[pos].flip();
+    return *this;
+  }
+
+  // 整体置 1 / 清 0 / 取反
+  dynamic_bitset &set() noexcept {
+    std::fill(words_.begin(), words_.end(), ~word_type{0});
+    clear_unused_bits();
+    return *this;
+  }
+  dynamic_bitset &reset() noexcept {
+    std::fill(words_.begin(), words_.end(), word_type{0});
+    return *this;
+  }
+  dynamic_bitset &flip() noexcept {
+    for (word_type &w : words_) {
+      w = ~w;
+    }
+    clear_unused_bits();
+    return *this;
+  }
+
+  void push_back(bool value) {
+    if (size_ % bits_per_word == 0) {
+      words_.push_back(0);
+    }
+    ++size_;
+    (*this)[size_ - 1] = value;
+  }
+  void pop_back() {
+    if (size_ == 0) {
+      return;
+    }
+    (*this)[size_ - 1] = false;
+    --size_;
+    if (size_ % bits_per_word == 0) {
+      words_.pop_back();
+    }
+  }
+
+  // 新增的位都设为 value
+  void resize(size_type count, bool value = false) {
+    size_type old_size = size_;
+    words_.resize(word_count(count), value ? ~word_type{0} : word_type{0});
+    size_ = count;
+    if (value && count > old_size && old_size % bits_per_word != 0) {
+      // 原来最后一个字里没用到的位现在成了新元素
+      words_[old_size / bits_per_word] |= ~word_type{0}
+                                          << (old_size % bits_per_word);
+    }
+    clear_unused_bits();
+  }
+  void reserve(size_type bits) { words_.reserve(word_count(bits)); }
+  void clear() noexcept {
+    words_.clear();
+    size_ = 0;
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  // 底层字数组，位 i 在 words()[i / 64] 的第 i % 64 位
+  std::span<const word_type> words() const noexcept {
+    return {words_.data(), words_.size()};
+  }
+
+  // 置 1 的位数（按字 popcount）
+  size_type count() const noexcept {
+    return detail::bit_kernels::popcount(words_.data(), words_.size());
+  }
+  bool any() const noexcept {
+    return std::any_of(words_.begin(), words_.end(),
+                       [](word_type w) { return w != 0; });
+  }
+  bool none() const noexcept { return !any(); }
+  bool all() const noexcept { return count() == size_; }
+
+  // 第一个置 1 的位；没有时返回 npos
+  size_type find_first() const noexcept { return find_from_word(0); }
+
+  // pos 之后第一个置 1 的位；没有时返回 npos
+  size_type find_next(size_type pos) const noexcept {
+    // 先判断再加一：pos 为 npos 时加一会回绕到 0
+    if (pos >= size_ || pos + 1 >= size_) {
+      return npos;
+    }
+    ++pos;
+    size_type index = pos / bits_per_word;
+    word_type w = words_[index] & (~word_type{0} << (pos % bits_per_word));
+    if (w != 0) {
+      return index * bits_per_word + std::countr_zero(w);
+    }
+    return find_from_word(index + 1);
+  }
+
+  // 按位运算，两边长度必须相同
+  dynamic_bitset &operator&=(const dynamic_bitset &other) {
+    return apply<detail::bit_kernels::bit_op::and_>(other);
+  }
+  dynamic_bitset &operator|=(const dynamic_bitset &other) {
+    return apply<detail::bit_kernels::bit_op::or_>(other);
+  }
+  dynamic_bitset &operator^=(const dynamic_bitset &other) {
+    return apply<detail::bit_kernels::bit_op::xor_>(other);
+  }
+  // this &= ~other
+  dynamic_bitset &and_not(const dynamic_bitset &other) {
+    return apply<detail::bit_kernels::bit_op::and_not>(other);
+  }
+
+  friend dynamic_bitset operator&(dynamic_bitset lhs,
+                                  const dynamic_bitset &rhs) {
+    return std::move(lhs &= rhs);
+  }
+  friend dynamic_bitset operator|(dynamic_bitset lhs,
+                                  const dynamic_bitset &rhs) {
+    return std::move(lhs |= rhs);
+  }
+  friend dynamic_bitset operator^(dynamic_bitset lhs,
+                                  const dynamic_bitset &rhs) {
+    return std::move(lhs ^= rhs);
+  }
+
+  friend bool operator==(const dynamic_bitset &lhs,
+                         const dynamic_bitset &rhs) noexcept {
+    return lhs.size_ == rhs.size_ &&
+           std::equal(lhs.words_.begin(), lhs.words_.end(),
+                      rhs.words_.begin());
+  }
+
+  // 打印所有位，下标 0 在最左边
+  void printElements() const {
+    for (size_type i = 0; i < size_; ++i) {
+      std::cout << ((*this)[i] ? '1' : '0');
+    }
+    std::cout << std::endl;
+  }
+
+private:
+  vector<word_type, grow_2x, 64> words_;
+  size_type size_ = 0;
+
+  static constexpr size_type word_count(size_type bits) noexcept {
+    return (bits + bits_per_word - 1) / bits_per_word;
+  }
+  static constexpr word_type bit_mask(size_type pos) noexcept {
+    return word_type{1} << (pos % bits_per_word);
+  }
+
+  void clear_unused_bits() noexcept {
+    if (size_ % bits_per_word != 0) {
+      words_.back() &= ~(~word_type{0} << (size_ % bits_per_word));
+    }
+  }
+
+  size_type find_from_word(size_type index) const noexcept {
+    for (; index < words_.size(); ++index) {
+      if (words_[index] != 0) {
+        return index * bits_per_word + std::countr_zero(words_[index]);
+      }
+    }
+    return npos;
+  }
+
+  template <detail::bit_kernels::bit_op Op>
+  dynamic_bitset &apply(const dynamic_bitset &other) {
+    if (other.size_ != size_)
+      throw std::invalid_argument("dynamic_bitset sizes differ");
+    detail::bit_kernels::apply<Op>(words_.data(), other.words_.data(),
+                                   words_.size());
+    return *this;
+  }
+};
+
+} // namespace my_stl
@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "dynamic_bitset.hpp"
+
+TEST_CASE("my_stl::dynamic_bitset packs 64 flags per word") {
+  my_stl::dynamic_bitset bits;
+  REQUIRE(bits.empty());
+  REQUIRE(bits.find_first() == my_stl::dynamic_bitset::npos);
+
+  for (std::size_t i = 0; i < 130; ++i) {
+    bits.push_back(i % 3 == 0);
+  }
+  REQUIRE(bits.size() == 130);
+  REQUIRE(bits.words().size() == 3);
+  REQUIRE(bits.count() == 44);
+  REQUIRE(bits[0]);
+  REQUIRE_FALSE(bits[1]);
+  REQUIRE(bits.test(129));
+  REQUIRE_THROWS_AS(bits.test(130), std::out_of_range);
+
+  bits[1] = true;
+  bits[0].flip();
+  REQUIRE(bits[1]);
+  REQUIRE_FALSE(bits[0]);
+  bits[2] = bits[1];
+  REQUIRE(bits[2]);
+
+  bits.pop_back();
+  bits.pop_back();
+  REQUIRE(bits.size() == 128);
+  REQUIRE(bits.words().size() == 2);
+}
+
+TEST_CASE("my_stl::dynamic_bitset keeps bits past size() cleared") {
+  my_stl::dynamic_bitset bits(70);
+  bits.set();
+  REQUIRE(bits.count() == 70);
+  REQUIRE(bits.all());
+  REQUIRE(bits.words()[1] == 0x3f);
+
+  bits.flip();
+  REQUIRE(bits.none());
+
+  bits.resize(100, true);
+  REQUIRE(bits.count() == 30);
+  REQUIRE(bits.find_first() == 70);
+  REQUIRE_FALSE(bits[69]);
+
+  bits.resize(75);
+  REQUIRE(bits.count() == 5);
+  bits.resize(100);
+  REQUIRE(bits.count() == 5);
+
+  bits.reset();
+  REQUIRE(bits.none());
+}
+
+TEST_CASE("my_stl::dynamic_bitset find_first/find_next walk set bits") {
+  my_stl::dynamic_bitset bits(1000);
+  const std::size_t expected[] = {3, 63, 64, 65, 500, 999};
+  for (std::size_t pos : expected) {
+    bits.set(pos);
+  }
+
+  std::size_t i = 0;
+  for (std::size_t pos = bits.find_first(); pos != bits.npos;
+       pos = bits.find_next(pos)) {
+    REQUIRE(i < std::size(expected));
+    REQUIRE(pos == expected[i++]);
+  }
+  REQUIRE(i == std::size(expected));
+  REQUIRE(bits.find_next(999) == bits.npos);
+  REQUIRE(bits.find_next(bits.npos) == bits.npos);
+}
+
+TEST_CASE("my_stl::dynamic_bitset bulk AND/OR/XOR/ANDNOT") {
+  // 长度不是 256 的倍数，覆盖向量化主循环和尾部
+  const std::size_t n = 1000;
+  my_stl::dynamic_bitset a(n);
+  my_stl::dynamic_bitset b(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    a[i] = i % 2 == 0;
+    b[i] = i % 3 == 0;
+  }
+
+  auto both = a & b;
+  auto either = a | b;
+  auto diff = a ^ b;
+  auto only_a = a;
+  only_a.and_not(b);
+  for (std::size_t i = 0; i < n; ++i) {
+    REQUIRE(both[i] == (a[i] && b[i]));
+    REQUIRE(either[i] == (a[i] || b[i]));
+    REQUIRE(diff[i] == (a[i] != b[i]));
+    REQUIRE(only_a[i] == (a[i] && !b[i]));
+  }
+  REQUIRE(both.count() == 167);
+  REQUIRE(either.count() + both.count() == a.count() + b.count());
+
+  REQUIRE((a ^ a).none());
+  REQUIRE((a | a) == a);
+  REQUIRE_FALSE(a == b);
+
+  my_stl::dynamic_bitset shorter(n - 1);
+  REQUIRE_THROWS_AS(a &= shorter, std::invalid_argument);
+}
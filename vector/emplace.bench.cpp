@@ -0,0 +1,82 @@
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// 统计全局 operator new 的调用次数，用来比较每次 append 的分配次数
+static std::size_t g_allocations = 0;
+
+void *operator new(std::size_t n) {
+  ++g_allocations;
+  if (void *p = std::malloc(n == 0 ? 1 : n))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr std::size_t kCount = 1'000'000;
+constexpr std::size_t kInserts = 2000;
+constexpr std::size_t kPayload = 64; // 超过 SSO，保证字符串一定在堆上
+
+template <typename Fn>
+void run(const char *name, std::size_t appends, Fn fn) {
+  std::size_t before = g_allocations;
+  auto start = std::chrono::steady_clock::now();
+  std::size_t checksum = fn();
+  auto stop = std::chrono::steady_clock::now();
+  std::size_t allocs = g_allocations - before;
+
+  double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+  std::printf("%-28s %8.2f ms  %6.3f allocs/append  (checksum %zu)\n", name,
+              ms, static_cast<double>(allocs) / appends, checksum);
+}
+
+} // namespace
+
+int main() {
+  std::printf("appending %zu strings of %zu chars\n", kCount, kPayload);
+
+  run("push_back(const T&)", kCount, [] {
+    my_stl::vector<std::string> v;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      std::string s(kPayload, 'a');
+      v.push_back(s);
+    }
+    return v.size();
+  });
+
+  run("push_back(T&&)", kCount, [] {
+    my_stl::vector<std::string> v;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      std::string s(kPayload, 'a');
+      v.push_back(std::move(s));
+    }
+    return v.size();
+  });
+
+  run("emplace_back(count, ch)", kCount, [] {
+    my_stl::vector<std::string> v;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      v.emplace_back(kPayload, 'a');
+    }
+    return v.size();
+  });
+
+  run("insert(0, T&&)", kInserts, [] {
+    my_stl::vector<std::string> v;
+    for (std::size_t i = 0; i < kInserts; ++i) {
+      std::string s(kPayload, 'a');
+      v.insert(0, std::move(s));
+    }
+    return v.size();
+  });
+
+  return 0;
+}
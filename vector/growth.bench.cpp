@@ -0,0 +1,72 @@
+#include "deque/deque.h"
+#include "stable_vector.hpp"
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// 每个策略在单独的子进程里跑，这样 ru_maxrss 就是这个策略自己的峰值 RSS
+
+namespace {
+
+constexpr std::size_t kAppends = 20'000'000; // 8 字节元素，最终约 160 MB
+
+long peak_rss_kb() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+template <typename Container> void bench_one(const char *name) {
+  std::fflush(stdout);
+  pid_t pid = fork();
+  if (pid != 0) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return;
+  }
+
+  long base_kb = peak_rss_kb();
+  auto start = std::chrono::steady_clock::now();
+  Container c;
+  for (std::size_t i = 0; i < kAppends; ++i) {
+    c.push_back(static_cast<std::uint64_t>(i));
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  double sec = std::chrono::duration<double>(stop - start).count();
+  double payload_mb = kAppends * sizeof(std::uint64_t) / 1048576.0;
+  double peak_mb = (peak_rss_kb() - base_kb) / 1024.0;
+  std::printf("%-28s %8.1f M appends/s  peak RSS %7.1f MB  (%.2fx payload)"
+              "  last %llu\n",
+              name, kAppends / sec / 1e6, peak_mb, peak_mb / payload_mb,
+              static_cast<unsigned long long>(c[c.size() - 1]));
+  std::fflush(stdout);
+  _exit(0);
+}
+
+} // namespace
+
+int main() {
+  using u64 = std::uint64_t;
+
+  std::printf("%zu push_back of uint64_t per run\n", kAppends);
+  bench_one<my_stl::vector<u64, my_stl::grow_2x>>("vector grow_2x");
+  bench_one<my_stl::vector<u64, my_stl::grow_1_5x>>("vector grow_1_5x");
+  bench_one<my_stl::vector<u64, my_stl::grow_size_class>>(
+      "vector grow_size_class");
+  bench_one<my_stl::vector<u64, my_stl::grow_fixed<(1u << 20)>>>(
+      "vector grow_fixed<1M>");
+
+  // 分段存储：扩容不拷贝，峰值里没有新旧两份缓冲区
+  bench_one<my_stl::stable_vector<u64>>("stable_vector");
+
+  // deque 的容量总是 2 的幂，只接受 grow_2x
+  bench_one<my_stl::deque<u64, my_stl::grow_2x>>("deque grow_2x");
+  return 0;
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+#include "growth_policy.hpp"
+#include "vector.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace my_stl {
+
+// 以文件为存储的 vector：元素直接放在 mmap(MAP_SHARED) 映射的文件里，
+// 扩容时先 ftruncate 加长文件再 mremap 扩大映射。
+// 重新打开同一个文件不需要解析或拷贝，页面在第一次访问时才由内核读入。
+//
+// 文件布局：64 字节的 file_header，后面紧跟 capacity 个 T。
+// size 存在映射的 header 里，每次修改都直接落到页缓存中；
+// 析构时把文件截断到 size 个元素。
+// 被移动后的对象不再关联文件：size 和 capacity 都是 0，可以读、clear、
+// pop_back、析构或被重新赋值，需要加长文件的操作（push_back、reserve 等）
+// 抛 std::logic_error。
+// 只支持平凡可复制的 T，文件内容与本机的字节序和类型布局相关。
+template <typename T, typename Growth = grow_2x> class mmap_vector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "mmap_vector stores raw bytes and needs trivially "
+                "copyable elements");
+  static_assert(alignof(T) <= 64, "elements are stored at a 64 byte offset");
+
+  struct alignas(64) file_header {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint64_t size;
+  };
+
+  static constexpr std::uint64_t file_magic = 0x564d4d4c5453594d; // "MYSTLMMV"
+  static constexpr std::uint32_t file_version = 1;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = typename vector<T>::iterator;
+  using const_iterator = typename vector<T>::const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // 打开 path，不存在时创建一个空文件；
+  // 已有文件的 header 对不上（不是 mmap_vector 或元素大小不同）时抛 runtime_error
+  explicit mmap_vector(const std::string &path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      throw_errno("mmap_vector: open " + path);
+    }
+    try {
+      open_mapping(path);
+    } catch (...) {
+      ::close(fd_);
+      throw;
+    }
+  }
+
+  // 析构时把文件截断到实际使用的长度并解除映射
+  ~mmap_vector() { close(); }
+
+  mmap_vector(const mmap_vector &) = delete;
+  mmap_vector &operator=(const mmap_vector &) = delete;
+
+  mmap_vector(mmap_vector &&other) noexcept
+      : fd_(std::exchange(other.fd_, -1)),
+        header_(std::exchange(other.header_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+
+  mmap_vector &operator=(mmap_vector &&other) noexcept {
+    if (this != &other) {
+      close();
+      fd_ = std::exchange(other.fd_, -1);
+      header_ = std::exchange(other.header_, nullptr);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  T &operator[](std::size_t pos) { return elements()[pos]; }
+  const T &operator[](std::size_t pos) const { return elements()[pos]; }
+
+  // 删除末尾的元素
+  void pop_back() {
+    if (!empty()) {
+      --header_->size;
+    }
+  }
+
+  // 清空数组但保留文件中已分配的容量
+  void clear() noexcept {
+    if (header_ != nullptr) {
+      header_->size = 0;
+    }
+  }
+
+  // 添加元素到末尾，容量不够时加长文件
+  void push_back(const T &value) { emplace_back(value); }
+
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    // 先构造出来，参数可能引用即将被 mremap 移走的元素
+    T tmp(std::forward<Args>(args)...);
+    if (size() == capacity_) {
+      remap(Growth::next_capacity(capacity_, size() + 1));
+    }
+    T *slot = elements() + header_->size;
+    std::memcpy(static_cast<void *>(slot), &tmp, sizeof(T));
+    ++header_->size;
+    return *slot;
+  }
+
+  // 保证至少能容纳 new_cap 个元素
+  void reserve(size_type new_cap) {
+    if (new_cap > capacity_) {
+      remap(new_cap);
+    }
+  }
+
+  // 改变元素个数，新增的元素值初始化
+  void resize(size_type count) {
+    if (count <= size()) {
+      if (header_ != nullptr) {
+        header_->size = count;
+      }
+      return;
+    }
+    reserve(count);
+    const T zero{};
+    for (size_type i = header_->size; i < count; ++i) {
+      std::memcpy(static_cast<void *>(elements() + i), &zero, sizeof(T));
+    }
+    header_->size = count;
+  }
+
+  size_t size() const noexcept {
+    return header_ != nullptr ? header_->size : 0;
+  }
+  size_t capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return size() == 0; }
+
+  reference front() {
+    if (empty())
+      throw std::out_of_range("mmap_vector::front on empty vector");
+    return elements()[0];
+  }
+  const_reference front() const {
+    if (empty())
+      throw std::out_of_range("mmap_vector::front on empty vector");
+    return elements()[0];
+  }
+
+  reference back() {
+    if (empty())
+      throw std::out_of_range("mmap_vector::back on empty vector");
+    return elements()[size() - 1];
+  }
+  const_reference back() const {
+    if (empty())
+      throw std::out_of_range("mmap_vector::back on empty vector");
+    return elements()[size() - 1];
+  }
+
+  pointer data() noexcept { return elements(); }
+  const_pointer data() const noexcept { return elements(); }
+
+  // at
+  T &at(std::size_t pos) {
+    if (pos >= size())
+      throw std::out_of_range("mmap_vector::at out of range");
+    return elements()[pos];
+  }
+  const T &at(std::size_t pos) const {
+    if (pos >= size())
+      throw std::out_of_range("mmap_vector::at out of range");
+    return elements()[pos];
+  }
+
+  // 打印数组中的元素
+  void printElements() const {
+    for (size_t i = 0; i < size(); ++i) {
+      std::cout << elements()[i] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  // 把脏页同步写回磁盘（msync），返回后即使机器掉电数据也不会丢
+  void flush() {
+    if (header_ != nullptr &&
+        ::msync(header_, mapped_bytes(capacity_), MS_SYNC) != 0) {
+      throw_errno("mmap_vector: msync");
+    }
+  }
+
+  // 迭代器 interface
+  iterator begin() noexcept { return iterator(elements()); }
+  iterator end() noexcept { return iterator(elements() + size()); }
+
+  const_iterator begin() const noexcept { return const_iterator(elements()); }
+  const_iterator end() const noexcept {
+    return const_iterator(elements() + size());
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+private:
+  int fd_ = -1;
+  file_header *header_ = nullptr; // 映射的起始地址
+  size_t capacity_ = 0;           // 文件里能放下的元素个数
+
+  [[noreturn]] static void throw_errno(const std::string &what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  static constexpr size_t mapped_bytes(size_t capacity) noexcept {
+    return sizeof(file_header) + capacity * sizeof(T);
+  }
+
+  T *elements() const noexcept {
+    if (header_ == nullptr) {
+      return nullptr;
+    }
+    return reinterpret_cast<T *>(reinterpret_cast<char *>(header_) +
+                                 sizeof(file_header));
+  }
+
+  void open_mapping(const std::string &path) {
+    struct stat st {};
+    if (::fstat(fd_, &st) != 0) {
+      throw_errno("mmap_vector: fstat " + path);
+    }
+    size_t file_bytes = static_cast<size_t>(st.st_size);
+
+    bool fresh = file_bytes == 0;
+    if (fresh) {
+      file_bytes = sizeof(file_header);
+      if (::ftruncate(fd_, static_cast<off_t>(file_bytes)) != 0) {
+        throw_errno("mmap_vector: ftruncate " + path);
+      }
+    } else if (file_bytes < sizeof(file_header) ||
+               (file_bytes - sizeof(file_header)) % sizeof(T) != 0) {
+      throw std::runtime_error("mmap_vector: " + path +
+                               " has an unexpected length");
+    }
+
+    void *p = ::mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd_, 0);
+    if (p == MAP_FAILED) {
+      throw_errno("mmap_vector: mmap " + path);
+    }
+    header_ = static_cast<file_header *>(p);
+    capacity_ = (file_bytes - sizeof(file_header)) / sizeof(T);
+
+    if (fresh) {
+      *header_ = file_header{file_magic, file_version,
+                             static_cast<std::uint32_t>(sizeof(T)), 0};
+    } else if (header_->magic != file_magic ||
+               header_->version != file_version ||
+               header_->element_size != sizeof(T) ||
+               header_->size > capacity_) {
+      ::munmap(header_, file_bytes);
+      header_ = nullptr;
+      throw std::runtime_error("mmap_vector: " + path +
+                               " is not a compatible mmap_vector file");
+    }
+  }
+
+  // 把文件和映射调整到 new_cap 个元素；地址可能改变
+  void remap(size_t new_cap) {
+    if (header_ == nullptr) {
+      throw std::logic_error("mmap_vector: moved-from vector has no file");
+    }
+    size_t old_bytes = mapped_bytes(capacity_);
+    size_t new_bytes = mapped_bytes(new_cap);
+    if (::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+      throw_errno("mmap_vector: ftruncate");
+    }
+#ifdef __linux__
+    void *p = ::mremap(header_, old_bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+    void *p = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd_, 0);
+    if (p != MAP_FAILED) {
+      ::munmap(header_, old_bytes);
+    }
+#endif
+    if (p == MAP_FAILED) {
+      int err = errno;
+      if (::ftruncate(fd_, static_cast<off_t>(old_bytes)) != 0) {
+        // 恢复原长度失败也只是文件末尾多出一段，忽略
+      }
+      errno = err;
+      throw_errno("mmap_vector: mremap");
+    }
+    header_ = static_cast<file_header *>(p);
+    capacity_ = new_cap;
+  }
+
+  void close() noexcept {
+    if (header_ != nullptr) {
+      size_t used = mapped_bytes(header_->size);
+      ::munmap(header_, mapped_bytes(capacity_));
+      if (::ftruncate(fd_, static_cast<off_t>(used)) != 0) {
+        // 截断失败时文件只是多占一些空间，下次打开照样可用
+      }
+      header_ = nullptr;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+};
+
+} // namespace my_stl
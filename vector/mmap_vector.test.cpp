@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <utility>
+
+#include "mmap_vector.hpp"
+
+namespace {
+
+struct Point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+// 测试结束时删除的临时文件
+struct TempFile {
+  std::string path;
+
+  explicit TempFile(const std::string &name)
+      : path((std::filesystem::temp_directory_path() /
+              (name + "." + std::to_string(::getpid())))
+                 .string()) {
+    std::filesystem::remove(path);
+  }
+  ~TempFile() { std::filesystem::remove(path); }
+};
+
+} // namespace
+
+TEST_CASE("my_stl::mmap_vector behaves like a vector") {
+  TempFile file("mmap_vector_basic");
+  my_stl::mmap_vector<std::int64_t> v(file.path);
+  REQUIRE(v.empty());
+  REQUIRE(v.capacity() == 0);
+
+  for (std::int64_t i = 0; i < 10000; ++i) {
+    v.push_back(i * 3);
+  }
+  REQUIRE(v.size() == 10000);
+  REQUIRE(v.capacity() >= 10000);
+  REQUIRE(v[1234] == 3702);
+  REQUIRE(v.front() == 0);
+  REQUIRE(v.back() == 29997);
+
+  // 参数引用自身元素，扩容时不能悬空
+  v.reserve(v.size());
+  v.push_back(v[1]);
+  REQUIRE(v.back() == 3);
+
+  v.pop_back();
+  v.resize(10002);
+  REQUIRE(v[10000] == 0);
+  REQUIRE(v[10001] == 0);
+  v.resize(5);
+
+  std::int64_t sum = 0;
+  for (std::int64_t x : v) {
+    sum += x;
+  }
+  REQUIRE(sum == 30);
+  REQUIRE(*v.crbegin() == 12);
+  REQUIRE_THROWS_AS(v.at(5), std::out_of_range);
+
+  v.clear();
+  REQUIRE(v.empty());
+  REQUIRE_THROWS_AS(v.front(), std::out_of_range);
+}
+
+TEST_CASE("my_stl::mmap_vector contents survive reopening") {
+  TempFile file("mmap_vector_reopen");
+  {
+    my_stl::mmap_vector<Point> v(file.path);
+    for (std::int32_t i = 0; i < 5000; ++i) {
+      v.emplace_back(Point{i, -i});
+    }
+    v.flush();
+  }
+  // 关闭时截断到实际长度
+  REQUIRE(std::filesystem::file_size(file.path) == 64 + 5000 * sizeof(Point));
+
+  {
+    my_stl::mmap_vector<Point> v(file.path);
+    REQUIRE(v.size() == 5000);
+    REQUIRE(v.capacity() == 5000);
+    REQUIRE(v[4321].x == 4321);
+    REQUIRE(v[4321].y == -4321);
+
+    v.push_back(Point{7, 7});
+    my_stl::mmap_vector<Point> moved(std::move(v));
+    REQUIRE(moved.size() == 5001);
+  }
+
+  my_stl::mmap_vector<Point> v(file.path);
+  REQUIRE(v.size() == 5001);
+  REQUIRE(v.back().x == 7);
+}
+
+TEST_CASE("my_stl::mmap_vector rejects incompatible files") {
+  TempFile file("mmap_vector_bad");
+  {
+    my_stl::mmap_vector<std::int32_t> v(file.path);
+    v.push_back(1);
+    v.push_back(2);
+  }
+  REQUIRE_THROWS_AS(my_stl::mmap_vector<std::int64_t>(file.path),
+                    std::runtime_error);
+
+  {
+    std::ofstream out(file.path, std::ios::binary | std::ios::trunc);
+    out << std::string(64 + 8, 'x');
+  }
+  REQUIRE_THROWS_AS(my_stl::mmap_vector<std::int32_t>(file.path),
+                    std::runtime_error);
+
+  REQUIRE_THROWS_AS(
+      my_stl::mmap_vector<std::int32_t>("/nonexistent-dir/mmap_vector"),
+      std::system_error);
+}
+
+TEST_CASE("my_stl::mmap_vector moved-from object is empty and file-less") {
+  TempFile file("mmap_vector_moved");
+  my_stl::mmap_vector<std::int32_t> source(file.path);
+  source.push_back(1);
+  source.push_back(2);
+
+  my_stl::mmap_vector<std::int32_t> target(std::move(source));
+  REQUIRE(target.size() == 2);
+  REQUIRE(target.back() == 2);
+
+  REQUIRE(source.size() == 0);
+  REQUIRE(source.empty());
+  REQUIRE(source.capacity() == 0);
+  REQUIRE(source.begin() == source.end());
+  source.clear();
+  source.pop_back();
+  source.resize(0);
+  source.flush();
+  REQUIRE(source.empty());
+  REQUIRE_THROWS_AS(source.at(0), std::out_of_range);
+  REQUIRE_THROWS_AS(source.push_back(3), std::logic_error);
+  REQUIRE_THROWS_AS(source.reserve(1), std::logic_error);
+
+  // 被移动的对象可以重新接收一个文件
+  source = std::move(target);
+  REQUIRE(source.size() == 2);
+  REQUIRE(target.empty());
+  target.clear();
+}
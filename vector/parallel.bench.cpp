@@ -0,0 +1,91 @@
+#include "parallel_algorithms.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+// 不同线程数下 parallel_sort / transform / reduce 相对单线程 std 算法的加速比
+
+namespace {
+
+constexpr std::size_t kCount = 16'000'000;
+
+template <typename F> double time_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+my_stl::vector<std::int32_t> make_input() {
+  std::mt19937 rng(42);
+  my_stl::vector<std::int32_t> v;
+  v.resize_for_overwrite(kCount);
+  for (std::int32_t &x : v) {
+    x = static_cast<std::int32_t>(rng());
+  }
+  return v;
+}
+
+} // namespace
+
+int main() {
+  const my_stl::vector<std::int32_t> input = make_input();
+  my_stl::vector<std::int32_t> v;
+  my_stl::vector<std::int64_t> out;
+  out.resize_for_overwrite(kCount);
+  auto square = [](std::int32_t x) {
+    return static_cast<std::int64_t>(x) * x;
+  };
+
+  // 先写一遍 out，避免首次缺页的开销算进基线
+  std::transform(input.begin(), input.end(), out.begin(), square);
+
+  v = input;
+  double sort_base = time_ms([&] { std::sort(v.begin(), v.end()); });
+  double transform_base = time_ms(
+      [&] { std::transform(input.begin(), input.end(), out.begin(), square); });
+  std::int64_t sum = 0;
+  double reduce_base = time_ms([&] {
+    for (std::int32_t x : input) {
+      sum += x;
+    }
+  });
+  std::printf("%zu int32, hardware_concurrency %u\n", kCount,
+              std::thread::hardware_concurrency());
+  std::printf("std baseline: sort %.1f ms  transform %.1f ms  "
+              "reduce %.1f ms\n",
+              sort_base, transform_base, reduce_base);
+
+  std::size_t max_threads = std::max(4u, std::thread::hardware_concurrency());
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    my_stl::thread_pool pool(threads);
+
+    v = input;
+    double sort_ms =
+        time_ms([&] { my_stl::parallel_sort(pool, v.begin(), v.end()); });
+    bool sorted = std::is_sorted(v.begin(), v.end());
+    double transform_ms = time_ms([&] {
+      my_stl::parallel_transform(pool, input.begin(), input.end(),
+                                 out.begin(), square);
+    });
+    std::int64_t psum = 0;
+    double reduce_ms = time_ms([&] {
+      psum = my_stl::parallel_reduce(pool, input.begin(), input.end(),
+                                     std::int64_t{0});
+    });
+
+    std::printf("%2zu threads: sort %7.1f ms (%.2fx)  transform %6.1f ms "
+                "(%.2fx)  reduce %6.1f ms (%.2fx)%s\n",
+                threads, sort_ms, sort_base / sort_ms, transform_ms,
+                transform_base / transform_ms, reduce_ms,
+                reduce_base / reduce_ms,
+                sorted && psum == sum ? "" : "  MISMATCH");
+  }
+  return 0;
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <utility>
+
+#include "thread_pool.hpp"
+#include "vector.hpp"
+
+// 基于 thread_pool 的并行算法，接受任意随机访问迭代器：
+// my_stl::vector 的 iterator、data() 返回的裸指针都可以。
+// 每个算法都有显式传线程池和使用 thread_pool::default_pool() 两种重载。
+namespace my_stl {
+
+namespace detail {
+
+// 小于这个长度的区间不再拆分，直接在当前线程上顺序处理
+inline constexpr std::ptrdiff_t parallel_grain = 4096;
+
+// 把 [first, last) 切成若干块，第一块在当前线程上跑，其余交给线程池
+template <typename It, typename Body>
+void for_each_chunk(thread_pool &pool, It first, It last, Body &body) {
+  std::ptrdiff_t n = last - first;
+  if (n <= 0) {
+    return;
+  }
+  // 每个线程分 4 块，给 work stealing 留出均衡负载的余地
+  std::ptrdiff_t chunks = std::min<std::ptrdiff_t>(
+      static_cast<std::ptrdiff_t>(pool.concurrency()) * 4,
+      (n + parallel_grain - 1) / parallel_grain);
+  std::ptrdiff_t step = n / chunks;
+  std::ptrdiff_t extra = n % chunks;
+
+  task_group group(pool);
+  std::ptrdiff_t begin = step + (extra > 0 ? 1 : 0);
+  for (std::ptrdiff_t c = 1; c < chunks; ++c) {
+    std::ptrdiff_t end = begin + step + (c < extra ? 1 : 0);
+    group.run([&body, first, begin, end, c] {
+      body(first + begin, first + end, c);
+    });
+    begin = end;
+  }
+  body(first, first + (step + (extra > 0 ? 1 : 0)), std::ptrdiff_t{0});
+  group.wait();
+}
+
+// 合并两个有序区间到 out，按较长一侧的中点二分拆成两个可以并行的子合并；
+// 相等元素保持左区间在前
+template <typename It1, typename It2, typename Out, typename Compare>
+void parallel_merge(thread_pool &pool, It1 a_first, It1 a_last, It2 b_first,
+                    It2 b_last, Out out, Compare &comp) {
+  std::ptrdiff_t a_len = a_last - a_first;
+  std::ptrdiff_t b_len = b_last - b_first;
+  if (a_len + b_len <= parallel_grain * 4) {
+    std::merge(std::make_move_iterator(a_first),
+               std::make_move_iterator(a_last),
+               std::make_move_iterator(b_first),
+               std::make_move_iterator(b_last), out, comp);
+    return;
+  }
+
+  It1 a_mid;
+  It2 b_mid;
+  if (a_len >= b_len) {
+    a_mid = a_first + a_len / 2;
+    b_mid = std::lower_bound(b_first, b_last, *a_mid, comp);
+  } else {
+    b_mid = b_first + b_len / 2;
+    a_mid = std::upper_bound(a_first, a_last, *b_mid, comp);
+  }
+  Out out_mid = out + (a_mid - a_first) + (b_mid - b_first);
+
+  task_group group(pool);
+  group.run([&pool, a_first, a_mid, b_first, b_mid, out, &comp] {
+    parallel_merge(pool, a_first, a_mid, b_first, b_mid, out, comp);
+  });
+  parallel_merge(pool, a_mid, a_last, b_mid, b_last, out_mid, comp);
+  group.wait();
+}
+
+// 归并排序的两个互相递归的半边，src 和 dst 等长：
+//   sort_into(src, dst)：排好的结果写到 dst，src 用作临时空间
+//   sort_in_place(src, dst)：排好的结果留在 src，dst 用作临时空间
+template <typename It1, typename It2, typename Compare>
+void sort_in_place(thread_pool &pool, It1 src, It1 src_last, It2 dst,
+                   Compare &comp);
+
+template <typename It1, typename It2, typename Compare>
+void sort_into(thread_pool &pool, It1 src, It1 src_last, It2 dst,
+               Compare &comp) {
+  std::ptrdiff_t n = src_last - src;
+  if (n <= parallel_grain * 4) {
+    std::sort(src, src_last, comp);
+    std::move(src, src_last, dst);
+    return;
+  }
+
+  std::ptrdiff_t half = n / 2;
+  task_group group(pool);
+  group.run([&pool, src, half, dst, &comp] {
+    sort_in_place(pool, src, src + half, dst, comp);
+  });
+  sort_in_place(pool, src + half, src_last, dst + half, comp);
+  group.wait();
+  parallel_merge(pool, src, src + half, src + half, src_last, dst, comp);
+}
+
+template <typename It1, typename It2, typename Compare>
+void sort_in_place(thread_pool &pool, It1 src, It1 src_last, It2 dst,
+                   Compare &comp) {
+  std::ptrdiff_t n = src_last - src;
+  if (n <= parallel_grain * 4) {
+    std::sort(src, src_last, comp);
+    return;
+  }
+
+  std::ptrdiff_t half = n / 2;
+  task_group group(pool);
+  group.run([&pool, src, half, dst, &comp] {
+    sort_into(pool, src, src + half, dst, comp);
+  });
+  sort_into(pool, src + half, src_last, dst + half, comp);
+  group.wait();
+  parallel_merge(pool, dst, dst + half, dst + half, dst + n, src, comp);
+}
+
+} // namespace detail
+
+// 对每个元素调用 f；f 会被多个线程同时调用
+template <std::random_access_iterator It, typename F>
+void parallel_for_each(thread_pool &pool, It first, It last, F f) {
+  auto body = [&f](It b, It e, std::ptrdiff_t) { std::for_each(b, e, f); };
+  detail::for_each_chunk(pool, first, last, body);
+}
+template <std::random_access_iterator It, typename F>
+void parallel_for_each(It first, It last, F f) {
+  parallel_for_each(thread_pool::default_pool(), first, last, std::move(f));
+}
+
+// d_first[i] = op(first[i])，返回输出区间的末尾
+template <std::random_access_iterator It, std::random_access_iterator Out,
+          typename UnaryOp>
+Out parallel_transform(thread_pool &pool, It first, It last, Out d_first,
+                       UnaryOp op) {
+  auto body = [&op, first, d_first](It b, It e, std::ptrdiff_t) {
+    std::transform(b, e, d_first + (b - first), op);
+  };
+  detail::for_each_chunk(pool, first, last, body);
+  return d_first + (last - first);
+}
+template <std::random_access_iterator It, std::random_access_iterator Out,
+          typename UnaryOp>
+Out parallel_transform(It first, It last, Out d_first, UnaryOp op) {
+  return parallel_transform(thread_pool::default_pool(), first, last, d_first,
+                            std::move(op));
+}
+
+// 分块求和再按块的顺序合并，要求 op 满足结合律（不要求交换律）
+template <std::random_access_iterator It, typename T,
+          typename BinaryOp = std::plus<>>
+T parallel_reduce(thread_pool &pool, It first, It last, T init,
+                  BinaryOp op = {}) {
+  vector<std::optional<T>> partials;
+  partials.resize(pool.concurrency() * 4);
+  auto body = [&op, &partials](It b, It e, std::ptrdiff_t c) {
+    T acc = *b;
+    for (++b; b != e; ++b) {
+      acc = op(std::move(acc), *b);
+    }
+    partials[static_cast<std::size_t>(c)].emplace(std::move(acc));
+  };
+  detail::for_each_chunk(pool, first, last, body);
+
+  for (std::optional<T> &p : partials) {
+    if (p) {
+      init = op(std::move(init), std::move(*p));
+    }
+  }
+  return init;
+}
+template <std::random_access_iterator It, typename T,
+          typename BinaryOp = std::plus<>>
+T parallel_reduce(It first, It last, T init, BinaryOp op = {}) {
+  return parallel_reduce(thread_pool::default_pool(), first, last,
+                         std::move(init), std::move(op));
+}
+
+// 并行归并排序（不稳定）：叶子用 std::sort，合并也按二分拆分并行执行。
+// 需要一块和输入等长的临时缓冲区
+template <std::random_access_iterator It, typename Compare = std::less<>>
+void parallel_sort(thread_pool &pool, It first, It last, Compare comp = {}) {
+  std::ptrdiff_t n = last - first;
+  if (n <= detail::parallel_grain * 4 || pool.concurrency() == 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  // 先把数据整体搬进缓冲区，再从缓冲区排序回原位置
+  using value_type = typename std::iterator_traits<It>::value_type;
+  vector<value_type> buf;
+  buf.reserve(static_cast<std::size_t>(n));
+  buf.assign(std::make_move_iterator(first), std::make_move_iterator(last));
+  detail::sort_into(pool, buf.data(), buf.data() + n, first, comp);
+}
+template <std::random_access_iterator It, typename Compare = std::less<>>
+void parallel_sort(It first, It last, Compare comp = {}) {
+  parallel_sort(thread_pool::default_pool(), first, last, std::move(comp));
+}
+
+} // namespace my_stl
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "parallel_algorithms.hpp"
+#include "vector.hpp"
+
+namespace {
+
+my_stl::vector<int> random_ints(std::size_t n, std::uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(-1000000, 1000000);
+  my_stl::vector<int> v;
+  v.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    v.push_back(dist(rng));
+  }
+  return v;
+}
+
+} // namespace
+
+TEST_CASE("my_stl::vector iterators are std random access iterators") {
+  STATIC_REQUIRE(std::random_access_iterator<my_stl::vector<int>::iterator>);
+  STATIC_REQUIRE(
+      std::random_access_iterator<my_stl::vector<int>::const_iterator>);
+}
+
+TEST_CASE("my_stl::task_group runs nested tasks and rethrows errors") {
+  my_stl::thread_pool pool(4);
+  REQUIRE(pool.concurrency() == 4);
+
+  std::atomic<int> sum{0};
+  {
+    my_stl::task_group outer(pool);
+    for (int i = 0; i < 8; ++i) {
+      outer.run([&pool, &sum] {
+        my_stl::task_group inner(pool);
+        for (int j = 0; j < 8; ++j) {
+          inner.run([&sum] { sum.fetch_add(1); });
+        }
+        inner.wait();
+      });
+    }
+    outer.wait();
+  }
+  REQUIRE(sum.load() == 64);
+
+  my_stl::task_group failing(pool);
+  failing.run([] { throw std::runtime_error("boom"); });
+  failing.run([&sum] { sum.fetch_add(1); });
+  REQUIRE_THROWS_AS(failing.wait(), std::runtime_error);
+  REQUIRE(sum.load() == 65);
+}
+
+TEST_CASE("my_stl::parallel_sort matches std::sort") {
+  for (std::size_t threads : {1, 2, 4}) {
+    my_stl::thread_pool pool(threads);
+    for (std::size_t n : {0, 1, 1000, 100000, 250001}) {
+      my_stl::vector<int> v = random_ints(n, static_cast<std::uint32_t>(n));
+      my_stl::vector<int> expected(v);
+      std::sort(expected.begin(), expected.end());
+
+      my_stl::parallel_sort(pool, v.begin(), v.end());
+      REQUIRE(std::equal(v.begin(), v.end(), expected.begin()));
+    }
+  }
+}
+
+TEST_CASE("my_stl::parallel_sort works on data() and custom comparators") {
+  my_stl::thread_pool pool(3);
+  my_stl::vector<int> v = random_ints(200000, 7);
+  my_stl::parallel_sort(pool, v.data(), v.data() + v.size(),
+                        std::greater<>{});
+  REQUIRE(std::is_sorted(v.begin(), v.end(), std::greater<>{}));
+
+  my_stl::vector<std::string> words;
+  for (int i = 0; i < 50000; ++i) {
+    words.push_back(std::to_string((i * 7919) % 50000));
+  }
+  my_stl::parallel_sort(pool, words.begin(), words.end());
+  REQUIRE(std::is_sorted(words.begin(), words.end()));
+  REQUIRE(words.size() == 50000);
+  REQUIRE(std::adjacent_find(words.begin(), words.end()) == words.end());
+}
+
+TEST_CASE("my_stl::parallel_transform, reduce and for_each") {
+  my_stl::thread_pool pool(4);
+  my_stl::vector<std::int64_t> v;
+  for (std::int64_t i = 0; i < 100000; ++i) {
+    v.push_back(i);
+  }
+
+  my_stl::vector<std::int64_t> squares;
+  squares.resize(v.size());
+  auto end = my_stl::parallel_transform(
+      pool, v.begin(), v.end(), squares.begin(),
+      [](std::int64_t x) { return x * x; });
+  REQUIRE(end == squares.end());
+  REQUIRE(squares[99999] == 99999LL * 99999LL);
+
+  REQUIRE(my_stl::parallel_reduce(pool, v.begin(), v.end(),
+                                  std::int64_t{10}) == 4999950000LL + 10);
+  REQUIRE(my_stl::parallel_reduce(pool, v.begin(), v.begin(), 3) == 3);
+
+  // 非交换但满足结合律的运算：按顺序拼接
+  my_stl::vector<std::string> parts;
+  for (int i = 0; i < 20000; ++i) {
+    parts.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+  }
+  std::string joined = my_stl::parallel_reduce(
+      pool, parts.data(), parts.data() + parts.size(), std::string());
+  REQUIRE(joined.size() == 20000);
+  REQUIRE(joined.substr(0, 3) == "abc");
+  REQUIRE(joined.substr(26, 2) == "ab");
+
+  my_stl::parallel_for_each(pool, v.begin(), v.end(),
+                            [](std::int64_t &x) { x = -x; });
+  REQUIRE(v[12345] == -12345);
+  REQUIRE(my_stl::parallel_reduce(v.begin(), v.end(), std::int64_t{0}) ==
+          -4999950000LL);
+}
@@ -0,0 +1,98 @@
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+namespace {
+
+// 一条紧凑的行情记录，trivially copyable，默认走 memcpy/memmove
+struct Tick {
+  std::uint64_t timestamp;
+  std::uint32_t instrument;
+  std::int32_t price;
+  std::int32_t quantity;
+  std::uint32_t flags;
+};
+
+// 布局完全相同，但关掉定制点，强制走逐元素搬运的循环
+struct LoopTick : Tick {};
+
+} // namespace
+
+template <>
+struct my_stl::is_trivially_relocatable<LoopTick> : std::false_type {};
+
+namespace {
+
+constexpr std::size_t kAppends = 10'000'000;
+constexpr std::size_t kShifts = 20'000;
+
+template <typename Fn> double time_ms(Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template <typename Rec> std::uint64_t sink(const my_stl::vector<Rec> &v) {
+  std::uint64_t sum = 0;
+  for (const auto &r : v) {
+    sum += r.timestamp;
+  }
+  return sum;
+}
+
+template <typename Rec> void bench(const char *name) {
+  std::uint64_t check = 0;
+
+  double grow = time_ms([&] {
+    my_stl::vector<Rec> v;
+    for (std::size_t i = 0; i < kAppends; ++i) {
+      Rec r{};
+      r.timestamp = i;
+      v.push_back(r);
+    }
+    check += sink(v);
+  });
+
+  double insert = time_ms([&] {
+    my_stl::vector<Rec> v;
+    for (std::size_t i = 0; i < kShifts; ++i) {
+      Rec r{};
+      r.timestamp = i;
+      v.insert(0, r);
+    }
+    check += sink(v);
+  });
+
+  double erase = time_ms([&] {
+    my_stl::vector<Rec> v;
+    for (std::size_t i = 0; i < kShifts; ++i) {
+      Rec r{};
+      r.timestamp = i;
+      v.push_back(r);
+    }
+    while (!v.empty()) {
+      v.erase(v.begin());
+    }
+    check += sink(v);
+  });
+
+  std::printf("%-10s grow %8.2f ms  insert(0) %8.2f ms  erase(begin) %8.2f ms"
+              "  (checksum %llu)\n",
+              name, grow, insert, erase,
+              static_cast<unsigned long long>(check));
+}
+
+} // namespace
+
+int main() {
+  std::printf("grow: %zu push_back, insert/erase: %zu ops at the front\n",
+              kAppends, kShifts);
+  bench<Tick>("memmove");
+  bench<LoopTick>("loop");
+  return 0;
+}
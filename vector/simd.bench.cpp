@@ -0,0 +1,95 @@
+#include "simd_algorithms.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <random>
+
+namespace {
+
+constexpr std::size_t kElements = 4'000'000; // 16/32 MB，超出 L2
+constexpr int kRepeats = 20;
+
+// 防止编译器把结果当成无用代码删掉
+template <typename T> void keep(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename Fn> double gb_per_s(std::size_t bytes, Fn fn) {
+  fn(); // 预热
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeats; ++i) {
+    fn();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double sec = std::chrono::duration<double>(stop - start).count();
+  return static_cast<double>(bytes) * kRepeats / sec / 1e9;
+}
+
+template <typename T> void bench(const char *type_name) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, 1000);
+  my_stl::vector<T> v;
+  v.reserve(kElements);
+  for (std::size_t i = 0; i < kElements; ++i) {
+    v.push_back(static_cast<T>(dist(rng)));
+  }
+  const T missing = static_cast<T>(-1); // find 需要扫完整个数组
+  const std::size_t bytes = kElements * sizeof(T);
+
+  struct row {
+    const char *name;
+    double std_gbs;
+    double simd_gbs;
+  };
+  row rows[] = {
+      {"find",
+       gb_per_s(bytes, [&] { keep(std::find(v.begin(), v.end(), missing)); }),
+       gb_per_s(bytes, [&] { keep(my_stl::simd::find(v, missing)); })},
+      {"count",
+       gb_per_s(bytes, [&] { keep(std::count(v.begin(), v.end(), T(7))); }),
+       gb_per_s(bytes, [&] { keep(my_stl::simd::count(v, T(7))); })},
+      {"min_element",
+       gb_per_s(bytes, [&] { keep(std::min_element(v.begin(), v.end())); }),
+       gb_per_s(bytes, [&] { keep(my_stl::simd::min_element(v)); })},
+      {"max_element",
+       gb_per_s(bytes, [&] { keep(std::max_element(v.begin(), v.end())); }),
+       gb_per_s(bytes, [&] { keep(my_stl::simd::max_element(v)); })},
+      {"accumulate",
+       gb_per_s(bytes, [&] { keep(std::accumulate(v.begin(), v.end(), T{})); }),
+       gb_per_s(bytes, [&] { keep(my_stl::simd::accumulate(v, T{})); })},
+  };
+
+  for (const row &r : rows) {
+    std::printf("%-8s %-12s std %7.2f GB/s   simd %7.2f GB/s   x%.2f\n",
+                type_name, r.name, r.std_gbs, r.simd_gbs,
+                r.simd_gbs / r.std_gbs);
+  }
+}
+
+const char *isa_name(my_stl::simd::isa level) {
+  switch (level) {
+  case my_stl::simd::isa::avx2:
+    return "AVX2";
+  case my_stl::simd::isa::sse42:
+    return "SSE4.2";
+  case my_stl::simd::isa::scalar:
+    break;
+  }
+  return "scalar";
+}
+
+} // namespace
+
+int main() {
+  std::printf("%zu elements, dispatching to %s\n", kElements,
+              isa_name(my_stl::simd::detected_isa()));
+  bench<std::int32_t>("int32_t");
+  bench<float>("float");
+  bench<double>("double");
+  return 0;
+}
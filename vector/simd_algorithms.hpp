@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+// 只在 GCC/Clang 的 x86 目标上提供 SSE4.2 / AVX2 内核，其余平台退回标量实现
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define MY_STL_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define MY_STL_SIMD_X86 0
+#endif
+
+// 对 my_stl::vector<int32_t / float / double> 这类连续容器的查找与归约。
+// 每个算法都有指针区间和容器两种重载；容器版本要求 data()/size()，
+// 并返回容器自己的 const_iterator。
+// 第一次调用时用 CPUID 检测指令集，之后按 AVX2 > SSE4.2 > 标量 分派。
+//
+// 浮点区间不能含 NaN：min/max 的向量指令对 NaN 的处理和 std:: 算法不同。
+namespace my_stl::simd {
+
+enum class isa { scalar, sse42, avx2 };
+
+template <typename T>
+concept kernel_type = std::same_as<T, std::int32_t> ||
+                      std::same_as<T, float> || std::same_as<T, double>;
+
+#if MY_STL_SIMD_X86
+
+namespace detail {
+
+// ===== SSE4.2：128 位寄存器 =====
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse4.2"))),               \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+#endif
+
+namespace sse42 {
+
+template <typename T> struct ops;
+
+template <> struct ops<std::int32_t> {
+  using T = std::int32_t;
+  using reg = __m128i;
+  static constexpr std::ptrdiff_t lanes = 4;
+
+  static reg load(const T *p) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static reg set1(T v) noexcept { return _mm_set1_epi32(v); }
+  static unsigned eq_mask(reg a, reg b) noexcept {
+    return static_cast<unsigned>(
+        _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm_min_epi32(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm_max_epi32(a, b); }
+  static reg add(reg a, reg b) noexcept { return _mm_add_epi32(a, b); }
+
+  static T reduce_min(reg a) noexcept {
+    a = _mm_min_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+    a = _mm_min_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(a);
+  }
+  static T reduce_max(reg a) noexcept {
+    a = _mm_max_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+    a = _mm_max_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(a);
+  }
+  static T reduce_add(reg a) noexcept {
+    a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+    a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(a);
+  }
+};
+
+template <> struct ops<float> {
+  using T = float;
+  using reg = __m128;
+  static constexpr std::ptrdiff_t lanes = 4;
+
+  static reg load(const T *p) noexcept { return _mm_loadu_ps(p); }
+  static reg set1(T v) noexcept { return _mm_set1_ps(v); }
+  static unsigned eq_mask(reg a, reg b) noexcept {
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b)));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm_min_ps(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm_max_ps(a, b); }
+  static reg add(reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+
+  static T reduce_min(reg a) noexcept {
+    a = _mm_min_ps(a, _mm_movehl_ps(a, a));
+    a = _mm_min_ss(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(a);
+  }
+  static T reduce_max(reg a) noexcept {
+    a = _mm_max_ps(a, _mm_movehl_ps(a, a));
+    a = _mm_max_ss(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(a);
+  }
+  static T reduce_add(reg a) noexcept {
+    a = _mm_add_ps(a, _mm_movehl_ps(a, a));
+    a = _mm_add_ss(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(a);
+  }
+};
+
+template <> struct ops<double> {
+  using T = double;
+  using reg = __m128d;
+  static constexpr std::ptrdiff_t lanes = 2;
+
+  static reg load(const T *p) noexcept { return _mm_loadu_pd(p); }
+  static reg set1(T v) noexcept { return _mm_set1_pd(v); }
+  static unsigned eq_mask(reg a, reg b) noexcept {
+    return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(a, b)));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm_min_pd(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm_max_pd(a, b); }
+  static reg add(reg a, reg b) noexcept { return _mm_add_pd(a, b); }
+
+  static T reduce_min(reg a) noexcept {
+    return _mm_cvtsd_f64(_mm_min_sd(a, _mm_unpackhi_pd(a, a)));
+  }
+  static T reduce_max(reg a) noexcept {
+    return _mm_cvtsd_f64(_mm_max_sd(a, _mm_unpackhi_pd(a, a)));
+  }
+  static T reduce_add(reg a) noexcept {
+    return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+  }
+};
+
+#include "simd_kernels.inl"
+
+} // namespace sse42
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+// ===== AVX2：256 位寄存器 =====
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))),                 \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace avx2 {
+
+template <typename T> struct ops;
+
+template <> struct ops<std::int32_t> {
+  using T = std::int32_t;
+  using reg = __m256i;
+  static constexpr std::ptrdiff_t lanes = 8;
+
+  static reg load(const T *p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static reg set1(T v) noexcept { return _mm256_set1_epi32(v); }
+  static unsigned eq_mask(reg a, reg b) noexcept {
+    return static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_epi32(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_epi32(a, b); }
+  static reg add(reg a, reg b) noexcept { return _mm256_add_epi32(a, b); }
+
+  // 先把高低两个 128 位合并，剩下的交给 SSE 版本
+  static T reduce_min(reg a) noexcept {
+    return sse42::ops<T>::reduce_min(_mm_min_epi32(
+        _mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)));
+  }
+  static T reduce_max(reg a) noexcept {
+    return sse42::ops<T>::reduce_max(_mm_max_epi32(
+        _mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)));
+  }
+  static T reduce_add(reg a) noexcept {
+    return sse42::ops<T>::reduce_add(_mm_add_epi32(
+        _mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)));
+  }
+};
+
+template <> struct ops<float> {
+  using T = float;
+  using reg = __m256;
+  static constexpr std::ptrdiff_t lanes = 8;
+
+  static reg load(const T *p) noexcept { return _mm256_loadu_ps(p); }
+  static reg set1(T v) noexcept { return _mm256_set1_ps(v); }
+  static unsigned eq_mask(reg a, reg b) noexcept {
+    return static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_ps(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_ps(a, b); }
+  static reg add(reg a, reg b) noexcept { return _mm256_add_ps(a, b); }
+
+  static T reduce_min(reg a) noexcept {
+    return sse42::ops<T>::reduce_min(
+        _mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+  }
+  static T reduce_max(reg a) noexcept {
+    return sse42::ops<T>::reduce_max(
+        _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+  }
+  static T reduce_add(reg a) noexcept {
+    return sse42::ops<T>::reduce_add(
+        _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+  }
+};
+
+template <> struct ops<double> {
+  using T = double;
+  using reg = __m256d;
+  static constexpr std::ptrdiff_t lanes = 4;
+
+  static reg load(const T *p) noexcept { return _mm256_loadu_pd(p); }
+  static reg set1(T v) noexcept { return _mm256_set1_pd(v); }
+  static unsigned eq_mask(reg a, reg b) noexcept {
+    return static_cast<unsigned>(
+        _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_pd(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_pd(a, b); }
+  static reg add(reg a, reg b) noexcept { return _mm256_add_pd(a, b); }
+
+  static T reduce_min(reg a) noexcept {
+    return sse42::ops<T>::reduce_min(
+        _mm_min_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1)));
+  }
+  static T reduce_max(reg a) noexcept {
+    return sse42::ops<T>::reduce_max(
+        _mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1)));
+  }
+  static T reduce_add(reg a) noexcept {
+    return sse42::ops<T>::reduce_add(
+        _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1)));
+  }
+};
+
+#include "simd_kernels.inl"
+
+} // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+} // namespace detail
+
+#endif // MY_STL_SIMD_X86
+
+// 当前 CPU 支持的最高指令集，只检测一次
+inline isa detected_isa() noexcept {
+#if MY_STL_SIMD_X86
+  static const isa level = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      return isa::avx2;
+    if (__builtin_cpu_supports("sse4.2"))
+      return isa::sse42;
+    return isa::scalar;
+  }();
+  return level;
+#else
+  return isa::scalar;
+#endif
+}
+
+// ===== 指针区间版本 =====
+
+template <kernel_type T>
+const T *find(const T *first, const T *last, T value) noexcept {
+#if MY_STL_SIMD_X86
+  switch (detected_isa()) {
+  case isa::avx2:
+    return detail::avx2::find(first, last, value);
+  case isa::sse42:
+    return detail::sse42::find(first, last, value);
+  case isa::scalar:
+    break;
+  }
+#endif
+  return std::find(first, last, value);
+}
+
+template <kernel_type T>
+std::size_t count(const T *first, const T *last, T value) noexcept {
+#if MY_STL_SIMD_X86
+  switch (detected_isa()) {
+  case isa::avx2:
+    return detail::avx2::count(first, last, value);
+  case isa::sse42:
+    return detail::sse42::count(first, last, value);
+  case isa::scalar:
+    break;
+  }
+#endif
+  return static_cast<std::size_t>(std::count(first, last, value));
+}
+
+template <kernel_type T>
+const T *min_element(const T *first, const T *last) noexcept {
+#if MY_STL_SIMD_X86
+  switch (detected_isa()) {
+  case isa::avx2:
+    return detail::avx2::min_element(first, last);
+  case isa::sse42:
+    return detail::sse42::min_element(first, last);
+  case isa::scalar:
+    break;
+  }
+#endif
+  return std::min_element(first, last);
+}
+
+template <kernel_type T>
+const T *max_element(const T *first, const T *last) noexcept {
+#if MY_STL_SIMD_X86
+  switch (detected_isa()) {
+  case isa::avx2:
+    return detail::avx2::max_element(first, last);
+  case isa::sse42:
+    return detail::sse42::max_element(first, last);
+  case isa::scalar:
+    break;
+  }
+#endif
+  return std::max_element(first, last);
+}
+
+template <kernel_type T>
+T accumulate(const T *first, const T *last, T init) noexcept {
+#if MY_STL_SIMD_X86
+  switch (detected_isa()) {
+  case isa::avx2:
+    return detail::avx2::accumulate(first, last, init);
+  case isa::sse42:
+    return detail::sse42::accumulate(first, last, init);
+  case isa::scalar:
+    break;
+  }
+#endif
+  return std::accumulate(first, last, init);
+}
+
+template <kernel_type T>
+bool contains(const T *first, const T *last, T value) noexcept {
+  return find(first, last, value) != last;
+}
+
+// ===== 容器版本 =====
+
+template <typename Container>
+concept contiguous_kernel_container = requires(const Container &c) {
+  { c.data() } -> std::convertible_to<const typename Container::value_type *>;
+  { c.size() } -> std::convertible_to<std::size_t>;
+  typename Container::const_iterator;
+} && kernel_type<typename Container::value_type>;
+
+template <contiguous_kernel_container C>
+typename C::const_iterator find(const C &c,
+                                typename C::value_type value) noexcept {
+  return typename C::const_iterator(
+      find(c.data(), c.data() + c.size(), value));
+}
+
+template <contiguous_kernel_container C>
+std::size_t count(const C &c, typename C::value_type value) noexcept {
+  return count(c.data(), c.data() + c.size(), value);
+}
+
+template <contiguous_kernel_container C>
+typename C::const_iterator min_element(const C &c) noexcept {
+  return typename C::const_iterator(
+      min_element(c.data(), c.data() + c.size()));
+}
+
+template <contiguous_kernel_container C>
+typename C::const_iterator max_element(const C &c) noexcept {
+  return typename C::const_iterator(
+      max_element(c.data(), c.data() + c.size()));
+}
+
+template <contiguous_kernel_container C>
+typename C::value_type accumulate(const C &c,
+                                  typename C::value_type init) noexcept {
+  return accumulate(c.data(), c.data() + c.size(), init);
+}
+
+template <contiguous_kernel_container C>
+bool contains(const C &c, typename C::value_type value) noexcept {
+  return contains(c.data(), c.data() + c.size(), value);
+}
+
+} // namespace my_stl::simd
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+#include "simd_algorithms.hpp"
+#include "vector.hpp"
+
+namespace {
+
+template <typename T> my_stl::vector<T> make_data(std::size_t n) {
+  std::mt19937 rng(static_cast<std::uint32_t>(n));
+  std::uniform_int_distribution<int> dist(-50, 50);
+  my_stl::vector<T> v;
+  for (std::size_t i = 0; i < n; ++i) {
+    v.push_back(static_cast<T>(dist(rng)));
+  }
+  return v;
+}
+
+// 各尺寸下，分派后的结果都要和 std:: 算法一致
+template <typename T> void check_against_std() {
+  for (std::size_t n : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 33, 100, 1000}) {
+    my_stl::vector<T> v = make_data<T>(n);
+    const T *first = v.data();
+    const T *last = first + v.size();
+
+    for (T needle : {T(-50), T(0), T(7), T(50), T(99)}) {
+      REQUIRE(my_stl::simd::find(first, last, needle) ==
+              std::find(first, last, needle));
+      REQUIRE(my_stl::simd::count(first, last, needle) ==
+              static_cast<std::size_t>(std::count(first, last, needle)));
+      REQUIRE(my_stl::simd::contains(v, needle) ==
+              (std::find(first, last, needle) != last));
+    }
+
+    REQUIRE(my_stl::simd::min_element(first, last) ==
+            std::min_element(first, last));
+    REQUIRE(my_stl::simd::max_element(first, last) ==
+            std::max_element(first, last));
+    // 数据都是小整数，浮点求和没有舍入误差，可以精确比较
+    REQUIRE(my_stl::simd::accumulate(first, last, T(1)) ==
+            std::accumulate(first, last, T(1)));
+  }
+}
+
+} // namespace
+
+TEST_CASE("my_stl::simd kernels match std algorithms for int32_t") {
+  check_against_std<std::int32_t>();
+}
+
+TEST_CASE("my_stl::simd kernels match std algorithms for float") {
+  check_against_std<float>();
+}
+
+TEST_CASE("my_stl::simd kernels match std algorithms for double") {
+  check_against_std<double>();
+}
+
+TEST_CASE("my_stl::simd container overloads return vector iterators") {
+  my_stl::vector<std::int32_t> v{5, 3, 9, 3, 9, 1, 7, 1, 2, 8};
+
+  REQUIRE(my_stl::simd::find(v, 9) == v.cbegin() + 2);
+  REQUIRE(my_stl::simd::find(v, 42) == v.cend());
+  REQUIRE(my_stl::simd::count(v, 3) == 2);
+  REQUIRE(my_stl::simd::min_element(v) == v.cbegin() + 5);
+  REQUIRE(my_stl::simd::max_element(v) == v.cbegin() + 2);
+  REQUIRE(my_stl::simd::accumulate(v, 0) == 48);
+  REQUIRE(my_stl::simd::contains(v, 7));
+  REQUIRE_FALSE(my_stl::simd::contains(v, 6));
+
+  my_stl::vector<double> empty;
+  REQUIRE(my_stl::simd::min_element(empty) == empty.cend());
+  REQUIRE(my_stl::simd::accumulate(empty, 2.5) == 2.5);
+}
+
+#if MY_STL_SIMD_X86
+TEST_CASE("my_stl::simd SSE4.2 kernels agree with AVX2 kernels") {
+  if (my_stl::simd::detected_isa() != my_stl::simd::isa::avx2) {
+    SUCCEED("AVX2 not available on this CPU");
+    return;
+  }
+
+  my_stl::vector<float> v = make_data<float>(1001);
+  const float *first = v.data();
+  const float *last = first + v.size();
+  namespace sse = my_stl::simd::detail::sse42;
+  namespace avx = my_stl::simd::detail::avx2;
+
+  REQUIRE(sse::find(first, last, 13.0f) == avx::find(first, last, 13.0f));
+  REQUIRE(sse::count(first, last, -2.0f) == avx::count(first, last, -2.0f));
+  REQUIRE(sse::min_element(first, last) == avx::min_element(first, last));
+  REQUIRE(sse::max_element(first, last) == avx::max_element(first, last));
+  REQUIRE(sse::accumulate(first, last, 0.0f) ==
+          avx::accumulate(first, last, 0.0f));
+}
+#endif
@@ -0,0 +1,99 @@
+// 与指令集无关的 SIMD 内核，由 simd_algorithms.hpp 在不同的 target 区域里
+// 各 include 一次。包含之前，当前命名空间里必须已经定义好 ops<T>：
+//   reg, lanes, load, set1, eq_mask, min, max, add,
+//   reduce_min, reduce_max, reduce_add
+// 不要直接 include 这个文件。
+
+template <typename T>
+const T *find(const T *first, const T *last, T value) noexcept {
+  using O = ops<T>;
+  const typename O::reg needle = O::set1(value);
+  for (; last - first >= O::lanes; first += O::lanes) {
+    unsigned mask = O::eq_mask(O::load(first), needle);
+    if (mask != 0) {
+      return first + __builtin_ctz(mask);
+    }
+  }
+  for (; first != last; ++first) {
+    if (*first == value) {
+      return first;
+    }
+  }
+  return last;
+}
+
+template <typename T>
+std::size_t count(const T *first, const T *last, T value) noexcept {
+  using O = ops<T>;
+  const typename O::reg needle = O::set1(value);
+  std::size_t n = 0;
+  for (; last - first >= O::lanes; first += O::lanes) {
+    n += static_cast<std::size_t>(
+        __builtin_popcount(O::eq_mask(O::load(first), needle)));
+  }
+  for (; first != last; ++first) {
+    n += *first == value ? 1 : 0;
+  }
+  return n;
+}
+
+// 最小值：区间不能为空
+template <typename T> T min_value(const T *first, const T *last) noexcept {
+  using O = ops<T>;
+  T result = *first;
+  if (last - first >= O::lanes) {
+    typename O::reg acc = O::load(first);
+    for (first += O::lanes; last - first >= O::lanes; first += O::lanes) {
+      acc = O::min(acc, O::load(first));
+    }
+    result = O::reduce_min(acc);
+  }
+  for (; first != last; ++first) {
+    result = *first < result ? *first : result;
+  }
+  return result;
+}
+
+// 最大值：区间不能为空
+template <typename T> T max_value(const T *first, const T *last) noexcept {
+  using O = ops<T>;
+  T result = *first;
+  if (last - first >= O::lanes) {
+    typename O::reg acc = O::load(first);
+    for (first += O::lanes; last - first >= O::lanes; first += O::lanes) {
+      acc = O::max(acc, O::load(first));
+    }
+    result = O::reduce_max(acc);
+  }
+  for (; first != last; ++first) {
+    result = result < *first ? *first : result;
+  }
+  return result;
+}
+
+// 先向量化求出最值，再向量化找到它第一次出现的位置
+template <typename T>
+const T *min_element(const T *first, const T *last) noexcept {
+  return first == last ? last : find(first, last, min_value(first, last));
+}
+
+template <typename T>
+const T *max_element(const T *first, const T *last) noexcept {
+  return first == last ? last : find(first, last, max_value(first, last));
+}
+
+// 每条 lane 各自累加，最后再横向求和；浮点数的求和顺序因此和
+// std::accumulate 不同，舍入结果可能有细微差别
+template <typename T>
+T accumulate(const T *first, const T *last, T init) noexcept {
+  using O = ops<T>;
+  typename O::reg acc = O::set1(T{});
+  for (; last - first >= O::lanes; first += O::lanes) {
+    acc = O::add(acc, O::load(first));
+  }
+  T tail{};
+  for (; first != last; ++first) {
+    tail += *first;
+  }
+  return init + (O::reduce_add(acc) + tail);
+}
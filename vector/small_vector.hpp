@@ -0,0 +1,329 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace my_stl {
+
+// 前 N 个元素直接放在对象内部的缓冲区里，超过 N 才转到堆上。
+// 接口和 my_stl::vector 一致，迭代器也直接复用 vector 的指针迭代器。
+template <typename T, std::size_t N> class small_vector {
+  static_assert(N > 0, "small_vector needs at least one inline slot");
+
+private:
+  T *elements;      // 指向 inline_buf_ 或堆上的缓冲区
+  size_t capacity_; // 在 inline_buf_ 中时等于 N
+  size_t size_;
+  alignas(T) unsigned char inline_buf_[sizeof(T) * N];
+
+  T *inline_data() noexcept {
+    return std::launder(reinterpret_cast<T *>(inline_buf_));
+  }
+  bool is_inline() const noexcept {
+    return elements == reinterpret_cast<const T *>(inline_buf_);
+  }
+
+  static T *allocate(size_t n) { return std::allocator<T>{}.allocate(n); }
+  void deallocate_heap() noexcept {
+    if (!is_inline())
+      std::allocator<T>{}.deallocate(elements, capacity_);
+  }
+
+  // 析构所有元素，堆上的缓冲区归还内存
+  void release() noexcept {
+    std::destroy(elements, elements + size_);
+    deallocate_heap();
+  }
+
+  // 扩展数组容量；inline 缓冲区放不下时才会走到这里分配堆内存
+  void reserve(size_t new_cap) {
+    if (new_cap <= capacity_)
+      return;
+
+    T *new_buf = allocate(new_cap);
+    try {
+      detail::relocate(elements, size_, new_buf);
+    } catch (...) {
+      std::allocator<T>{}.deallocate(new_buf, new_cap);
+      throw;
+    }
+
+    deallocate_heap();
+    elements = new_buf;
+    capacity_ = new_cap;
+  }
+
+  // 满了再 emplace_back：先在新缓冲区里构造新元素再搬旧元素，
+  // 这样参数引用的是自身元素时也不会悬空
+  template <typename... Args> T &grow_and_emplace_back(Args &&...args) {
+    size_t new_cap = 2 * capacity_;
+    T *new_buf = allocate(new_cap);
+    try {
+      std::construct_at(new_buf + size_, std::forward<Args>(args)...);
+      try {
+        detail::relocate(elements, size_, new_buf);
+      } catch (...) {
+        std::destroy_at(new_buf + size_);
+        throw;
+      }
+    } catch (...) {
+      std::allocator<T>{}.deallocate(new_buf, new_cap);
+      throw;
+    }
+
+    deallocate_heap();
+    elements = new_buf;
+    capacity_ = new_cap;
+    return elements[size_++];
+  }
+
+  // 接管 other 的元素：堆上的直接偷指针，inline 的逐个搬过来
+  void steal(small_vector &other) {
+    if (other.is_inline()) {
+      detail::relocate(other.elements, other.size_, elements);
+      size_ = std::exchange(other.size_, 0);
+    } else {
+      elements = std::exchange(other.elements, other.inline_data());
+      capacity_ = std::exchange(other.capacity_, N);
+      size_ = std::exchange(other.size_, 0);
+    }
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = typename vector<T>::iterator;
+  using const_iterator = typename vector<T>::const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // 内部缓冲区的容量
+  static constexpr size_type inline_capacity = N;
+
+  // 构造函数
+  small_vector() noexcept : elements(inline_data()), capacity_(N), size_(0) {}
+
+  // 委托构造完成后对象已经成立，中途抛异常会由析构函数清理
+  small_vector(std::initializer_list<T> ilist) : small_vector() {
+    reserve(ilist.size());
+    for (const auto &elem : ilist) {
+      std::construct_at(elements + size_, elem);
+      ++size_;
+    }
+  }
+
+  // 析构函数
+  ~small_vector() { release(); }
+
+  // 拷贝构造函数
+  small_vector(const small_vector &other) : small_vector() {
+    reserve(other.size_);
+    std::uninitialized_copy(other.elements, other.elements + other.size_,
+                            elements);
+    size_ = other.size_;
+  }
+
+  // 拷贝赋值操作符
+  small_vector &operator=(const small_vector &other) {
+    if (this == &other)
+      return *this;
+
+    clear();
+    reserve(other.size_);
+    std::uninitialized_copy(other.elements, other.elements + other.size_,
+                            elements);
+    size_ = other.size_;
+    return *this;
+  }
+
+  // Move constructor
+  small_vector(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : small_vector() {
+    steal(other);
+  }
+
+  // Move assignment
+  small_vector &operator=(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this == &other)
+      return *this;
+
+    release();
+    elements = inline_data();
+    capacity_ = N;
+    size_ = 0;
+    steal(other);
+    return *this;
+  }
+
+  T &operator[](std::size_t pos) { return elements[pos]; }
+  const T &operator[](std::size_t pos) const { return elements[pos]; }
+
+  // member function
+
+  // 删除数组末尾的元素
+  void pop_back() {
+    if (size_ > 0) {
+      --size_;
+      std::destroy_at(elements + size_);
+    }
+  }
+
+  // 在指定位置插入元素
+  void insert(size_t index, const T &value) {
+    if (index > size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    emplace(cbegin() + static_cast<std::ptrdiff_t>(index), value);
+  }
+  void insert(size_t index, T &&value) {
+    if (index > size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    emplace(cbegin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+  }
+
+  // 清空数组，析构所有元素但保留容量
+  void clear() noexcept {
+    std::destroy(elements, elements + size_);
+    size_ = 0;
+  }
+
+  // 添加元素到数组末尾
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  // 在数组末尾原地构造元素
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      return grow_and_emplace_back(std::forward<Args>(args)...);
+    }
+    std::construct_at(elements + size_, std::forward<Args>(args)...);
+    return elements[size_++];
+  }
+
+  // 获取数组中元素的个数
+  size_t size() const { return size_; }
+
+  // 获取数组的容量
+  size_t capacity() const { return capacity_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  // 元素是否还在对象内部的缓冲区里（没有堆分配）
+  bool is_small() const noexcept { return is_inline(); }
+
+  reference front() {
+    if (empty())
+      throw std::out_of_range("small_vector::front on empty vector");
+    return elements[0];
+  }
+  const_reference front() const {
+    if (empty())
+      throw std::out_of_range("small_vector::front on empty vector");
+    return elements[0];
+  }
+
+  reference back() {
+    if (empty())
+      throw std::out_of_range("small_vector::back on empty vector");
+    return elements[size_ - 1];
+  }
+  const_reference back() const {
+    if (empty())
+      throw std::out_of_range("small_vector::back on empty vector");
+    return elements[size_ - 1];
+  }
+
+  pointer data() noexcept { return elements; }
+  const_pointer data() const noexcept { return elements; }
+
+  // 打印数组中的元素
+  void printElements() const {
+    for (size_t i = 0; i < size_; ++i) {
+      std::cout << elements[i] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  // at
+  T &at(std::size_t pos) {
+    if (pos >= size_)
+      throw std::out_of_range("small_vector::at out of range");
+    return elements[pos];
+  }
+  const T &at(std::size_t pos) const {
+    if (pos >= size_)
+      throw std::out_of_range("small_vector::at out of range");
+    return elements[pos];
+  }
+
+  // 迭代器 interface
+  iterator begin() noexcept { return iterator(elements); }
+  iterator end() noexcept { return iterator(elements + size_); }
+
+  const_iterator begin() const noexcept { return const_iterator(elements); }
+  const_iterator end() const noexcept {
+    return const_iterator(elements + size_);
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  // 在 pos 处原地构造元素，尾部整体向后移动一位
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    size_type index = pos - cbegin();
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+      return begin() + static_cast<std::ptrdiff_t>(index);
+    }
+
+    // 参数可能引用数组内的元素，扩容和移动尾部之前先构造出来
+    T tmp(std::forward<Args>(args)...);
+    if (size_ == capacity_) {
+      reserve(capacity_ * 2);
+    }
+    detail::insert_shift(elements + index, elements + size_, std::move(tmp));
+    ++size_;
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type first_index = first - cbegin();
+    size_type last_index = last - cbegin();
+    size_type count = last_index - first_index;
+
+    if (count == 0) {
+      return begin() + static_cast<std::ptrdiff_t>(first_index);
+    }
+
+    detail::erase_shift(elements + first_index, elements + last_index,
+                        elements + size_);
+
+    size_ -= count;
+    return begin() + static_cast<std::ptrdiff_t>(first_index);
+  }
+};
+} // namespace my_stl
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "small_vector.hpp"
+
+TEST_CASE("my_stl::small_vector stays inline up to N elements") {
+  my_stl::small_vector<int, 4> v;
+  REQUIRE(v.empty());
+  REQUIRE(v.capacity() == 4);
+  REQUIRE(v.is_small());
+
+  for (int i = 0; i < 4; ++i) {
+    v.push_back(i);
+  }
+  REQUIRE(v.size() == 4);
+  REQUIRE(v.is_small());
+
+  v.push_back(4);
+  REQUIRE_FALSE(v.is_small());
+  REQUIRE(v.capacity() == 8);
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(v[i] == i);
+  }
+}
+
+TEST_CASE("my_stl::small_vector insert, emplace and erase") {
+  my_stl::small_vector<std::string, 2> v{"b", "d"};
+
+  v.insert(0, "a");
+  v.emplace(v.cbegin() + 2, "c");
+  v.insert(4, std::string("e"));
+
+  REQUIRE(v.size() == 5);
+  REQUIRE(v.front() == "a");
+  REQUIRE(v.back() == "e");
+
+  auto it = v.erase(v.begin() + 1, v.begin() + 3);
+  REQUIRE(*it == "d");
+  REQUIRE(v.size() == 3);
+  REQUIRE(v[0] == "a");
+  REQUIRE(v[1] == "d");
+  REQUIRE(v[2] == "e");
+
+  REQUIRE_THROWS_AS(v.insert(9, "x"), std::out_of_range);
+  REQUIRE_THROWS_AS(v.at(3), std::out_of_range);
+}
+
+TEST_CASE("my_stl::small_vector copy and move for inline and heap storage") {
+  my_stl::small_vector<std::string, 3> small{"x", "y"};
+  my_stl::small_vector<std::string, 3> big{"1", "2", "3", "4"};
+  REQUIRE(small.is_small());
+  REQUIRE_FALSE(big.is_small());
+
+  my_stl::small_vector<std::string, 3> small_copy(small);
+  REQUIRE(small_copy.is_small());
+  REQUIRE(small_copy[1] == "y");
+
+  my_stl::small_vector<std::string, 3> big_copy;
+  big_copy = big;
+  REQUIRE(big_copy.size() == 4);
+  REQUIRE(big_copy[3] == "4");
+
+  my_stl::small_vector<std::string, 3> small_moved(std::move(small));
+  REQUIRE(small_moved.is_small());
+  REQUIRE(small_moved.size() == 2);
+  REQUIRE(small.empty());
+
+  const std::string *heap = big.data();
+  my_stl::small_vector<std::string, 3> big_moved;
+  big_moved = std::move(big);
+  REQUIRE(big_moved.data() == heap);
+  REQUIRE(big.empty());
+  REQUIRE(big.is_small());
+
+  big_moved = std::move(small_moved);
+  REQUIRE(big_moved.is_small());
+  REQUIRE(big_moved[0] == "x");
+}
+
+TEST_CASE("my_stl::small_vector iterators are random access") {
+  my_stl::small_vector<std::unique_ptr<int>, 2> v;
+  v.emplace_back(new int(1));
+  v.emplace_back(new int(2));
+  v.push_back(std::make_unique<int>(3));
+
+  int expected = 1;
+  for (auto it = v.begin(); it != v.end(); ++it) {
+    REQUIRE(**it == expected++);
+  }
+
+  my_stl::small_vector<std::unique_ptr<int>, 2>::const_iterator cit = v.begin();
+  REQUIRE(v.cend() - cit == 3);
+  REQUIRE(**(cit + 2) == 3);
+  REQUIRE(**v.crbegin() == 3);
+
+  v.pop_back();
+  v.clear();
+  REQUIRE(v.empty());
+  REQUIRE(v.capacity() == 4);
+}
@@ -0,0 +1,112 @@
+#include "deque/deque.h"
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// 快照读写吞吐（GB/s）。文件写在临时目录，数据大多停留在页缓存里，
+// 所以测的主要是拷贝和校验和的开销，而不是磁盘速度
+
+namespace {
+
+constexpr std::size_t kCount = 32u << 20; // 32M 个 uint64_t，256 MB
+constexpr double kBytes = kCount * sizeof(std::uint64_t);
+
+template <typename F> double gbps(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return kBytes / std::chrono::duration<double>(stop - start).count() / 1e9;
+}
+
+int open_or_die(const std::string &path, int flags) {
+  int fd = ::open(path.c_str(), flags, 0644);
+  if (fd < 0) {
+    std::perror(path.c_str());
+    std::exit(1);
+  }
+  return fd;
+}
+
+} // namespace
+
+int main() {
+  std::string path =
+      (std::filesystem::temp_directory_path() / "snapshot_bench.bin").string();
+
+  my_stl::vector<std::uint64_t> v;
+  v.resize_for_overwrite(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    v[i] = i * 0x9E3779B97F4A7C15ULL;
+  }
+  std::printf("%zu uint64_t (%.0f MB)\n", kCount, kBytes / 1048576);
+
+  double per_element = gbps([&] {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (std::uint64_t x : v) {
+      out.write(reinterpret_cast<const char *>(&x), sizeof(x));
+    }
+  });
+  std::printf("%-32s %6.2f GB/s\n", "per-element ofstream::write",
+              per_element);
+
+  std::printf("%-32s %6.2f GB/s\n", "vector::save(ofstream)", gbps([&] {
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                v.save(out);
+              }));
+  std::printf("%-32s %6.2f GB/s\n", "vector::save(fd)", gbps([&] {
+                int fd = open_or_die(path, O_WRONLY | O_CREAT | O_TRUNC);
+                v.save(fd);
+                ::close(fd);
+              }));
+
+  my_stl::vector<std::uint64_t> loaded;
+  std::printf("%-32s %6.2f GB/s\n", "vector::load(ifstream)", gbps([&] {
+                std::ifstream in(path, std::ios::binary);
+                loaded.load(in);
+              }));
+  std::printf("%-32s %6.2f GB/s\n", "vector::load(fd)", gbps([&] {
+                int fd = open_or_die(path, O_RDONLY);
+                loaded.load(fd);
+                ::close(fd);
+              }));
+  std::printf("%-32s %6.2f GB/s\n", "mapped_snapshot + verify()", gbps([&] {
+                my_stl::mapped_snapshot<std::uint64_t> mapped(path);
+                if (!mapped.verify() || mapped.size() != kCount) {
+                  std::puts("  checksum mismatch");
+                }
+              }));
+
+  // 让 deque 的数据跨过缓冲区末尾，保存时要写两段
+  my_stl::deque<std::uint64_t> d;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    d.push_back(i);
+  }
+  for (std::size_t i = 0; i < kCount / 2; ++i) {
+    d.pop_front();
+    d.push_back(i);
+  }
+  std::printf("%-32s %6.2f GB/s\n", "deque::save(fd), two segments",
+              gbps([&] {
+                int fd = open_or_die(path, O_WRONLY | O_CREAT | O_TRUNC);
+                d.save(fd);
+                ::close(fd);
+              }));
+  std::printf("%-32s %6.2f GB/s\n", "deque::load(fd)", gbps([&] {
+                int fd = open_or_die(path, O_RDONLY);
+                d.load(fd);
+                ::close(fd);
+              }));
+
+  std::filesystem::remove(path);
+  return loaded.size() == kCount && d.size() == kCount ? 0 : 1;
+}
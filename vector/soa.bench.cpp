@@ -0,0 +1,113 @@
+#include "simd_algorithms.hpp"
+#include "soa_vector.hpp"
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+
+// 单字段扫描：结构体数组（每次把 32 字节的整条记录读进缓存）
+// 和结构数组（只读需要的那一列）对比
+
+namespace {
+
+constexpr std::size_t kCount = 8'000'000;
+constexpr int kRepeats = 10;
+
+struct Particle {
+  float x, y, z;
+  float vx, vy, vz;
+  float mass;
+  std::int32_t id;
+};
+static_assert(sizeof(Particle) == 32);
+
+using particle_soa = my_stl::soa_vector<float, float, float, float, float,
+                                        float, float, std::int32_t>;
+
+template <typename F> double time_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRepeats; ++r) {
+    f();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count() /
+         kRepeats;
+}
+
+} // namespace
+
+int main() {
+  my_stl::vector<Particle> aos;
+  particle_soa soa;
+  aos.reserve(kCount);
+  soa.reserve(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    float f = static_cast<float>(i % 1000) * 0.001f;
+    auto id = static_cast<std::int32_t>(i);
+    aos.push_back(Particle{f, f, f, 1.0f, 1.0f, 1.0f, f, id});
+    soa.emplace_back(f, f, f, 1.0f, 1.0f, 1.0f, f, id);
+  }
+
+  volatile float sink = 0;
+  std::printf("%zu particles, %zu bytes each, single-field scans\n", kCount,
+              sizeof(Particle));
+
+  double aos_sum = time_ms([&] {
+    float s = 0;
+    for (const Particle &p : aos) {
+      s += p.mass;
+    }
+    sink = s;
+  });
+  double soa_sum = time_ms([&] {
+    float s = 0;
+    for (float m : soa.column<6>()) {
+      s += m;
+    }
+    sink = s;
+  });
+  double soa_simd = time_ms([&] {
+    std::span<const float> mass = soa.column<6>();
+    sink = my_stl::simd::accumulate(mass.data(), mass.data() + mass.size(),
+                                    0.0f);
+  });
+  std::printf("sum(mass)    AoS %7.2f ms  SoA %7.2f ms (%.1fx)  "
+              "SoA+simd %7.2f ms (%.1fx)\n",
+              aos_sum, soa_sum, aos_sum / soa_sum, soa_simd,
+              aos_sum / soa_simd);
+
+  // 两列参与的更新：x += vx
+  double aos_update = time_ms([&] {
+    for (Particle &p : aos) {
+      p.x += p.vx;
+    }
+  });
+  double soa_update = time_ms([&] {
+    std::span<float> x = soa.column<0>();
+    std::span<const float> vx = soa.column<3>();
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      x[i] += vx[i];
+    }
+  });
+  std::printf("x += vx      AoS %7.2f ms  SoA %7.2f ms (%.1fx)\n", aos_update,
+              soa_update, aos_update / soa_update);
+
+  double aos_find = time_ms([&] {
+    std::size_t n = 0;
+    for (const Particle &p : aos) {
+      n += p.id == 7'654'321 ? 1 : 0;
+    }
+    sink = static_cast<float>(n);
+  });
+  double soa_find = time_ms([&] {
+    std::span<const std::int32_t> ids = soa.column<7>();
+    sink = static_cast<float>(my_stl::simd::count(
+        ids.data(), ids.data() + ids.size(), std::int32_t{7'654'321}));
+  });
+  std::printf("count(id)    AoS %7.2f ms  SoA+simd %7.2f ms (%.1fx)\n",
+              aos_find, soa_find, aos_find / soa_find);
+  return 0;
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace my_stl {
+
+// 结构数组（structure of arrays）：每个字段一列，每列是一个独立的
+// my_stl::vector，按 64 字节对齐，可以直接交给 simd:: 里的内核。
+// 只扫描某一个字段时只会把这一列读进缓存。
+//
+// 行通过代理访问：operator[] 返回 std::tuple<Ts &...>，
+// 可以 std::get、结构化绑定，也可以整体赋值一个 std::tuple<Ts...>。
+// 所有列的长度始终相同，扩容策略也相同，所以各列同步扩容。
+template <typename... Ts> class soa_vector {
+  static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+public:
+  template <typename T>
+  using column_storage =
+      vector<T, grow_2x, std::max<std::size_t>(alignof(T), 64)>;
+
+  template <std::size_t I>
+  using column_value_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+  using value_type = std::tuple<Ts...>;
+  using reference = std::tuple<Ts &...>;
+  using const_reference = std::tuple<const Ts &...>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  static constexpr size_type column_count = sizeof...(Ts);
+
+  soa_vector() = default;
+  soa_vector(std::initializer_list<value_type> rows) {
+    reserve(rows.size());
+    for (const value_type &row : rows) {
+      push_back(row);
+    }
+  }
+
+  // 行迭代器：解引用得到 reference 代理，不是真正的 T&，
+  // 所以只满足遍历和随机跳转，不能直接交给 std::sort
+  template <typename Owner, typename Ref> class row_iterator {
+    friend class soa_vector;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = typename soa_vector::value_type;
+    using reference = Ref;
+
+    row_iterator() noexcept : owner_(nullptr), index_(0) {}
+    // iterator 可以转换成 const_iterator
+    template <typename O, typename R>
+      requires std::is_convertible_v<O *, Owner *>
+    row_iterator(const row_iterator<O, R> &other) noexcept
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    row_iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    row_iterator operator++(int) {
+      row_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    row_iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    row_iterator operator--(int) {
+      row_iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    row_iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    row_iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    row_iterator operator+(difference_type n) const {
+      return row_iterator(owner_, index_ + n);
+    }
+    row_iterator operator-(difference_type n) const {
+      return row_iterator(owner_, index_ - n);
+    }
+    difference_type operator-(const row_iterator &rhs) const {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(rhs.index_);
+    }
+    friend row_iterator operator+(difference_type n, const row_iterator &it) {
+      return it + n;
+    }
+
+    auto operator<=>(const row_iterator &) const = default;
+
+  private:
+    template <typename, typename> friend class row_iterator;
+
+    Owner *owner_;
+    size_type index_;
+
+    row_iterator(Owner *owner, size_type index)
+        : owner_(owner), index_(index) {}
+  };
+
+  using iterator = row_iterator<soa_vector, reference>;
+  using const_iterator = row_iterator<const soa_vector, const_reference>;
+
+  reference operator[](size_type pos) {
+    return std::apply(
+        [pos](auto &...cols) { return reference(cols[pos]...); }, columns_);
+  }
+  const_reference operator[](size_type pos) const {
+    return std::apply(
+        [pos](const auto &...cols) { return const_reference(cols[pos]...); },
+        columns_);
+  }
+
+  // at
+  reference at(size_type pos) {
+    if (pos >= size())
+      throw std::out_of_range("soa_vector::at out of range");
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= size())
+      throw std::out_of_range("soa_vector::at out of range");
+    return (*this)[pos];
+  }
+
+  reference front() {
+    if (empty())
+      throw std::out_of_range("soa_vector::front on empty vector");
+    return (*this)[0];
+  }
+  const_reference front() const {
+    if (empty())
+      throw std::out_of_range("soa_vector::front on empty vector");
+    return (*this)[0];
+  }
+
+  reference back() {
+    if (empty())
+      throw std::out_of_range("soa_vector::back on empty vector");
+    return (*this)[size() - 1];
+  }
+  const_reference back() const {
+    if (empty())
+      throw std::out_of_range("soa_vector::back on empty vector");
+    return (*this)[size() - 1];
+  }
+
+  // 第 I 列的连续存储
+  template <std::size_t I> std::span<column_value_type<I>> column() noexcept {
+    auto &col = std::get<I>(columns_);
+    return {col.data(), col.size()};
+  }
+  template <std::size_t I>
+  std::span<const column_value_type<I>> column() const noexcept {
+    const auto &col = std::get<I>(columns_);
+    return {col.data(), col.size()};
+  }
+
+  template <std::size_t I> column_value_type<I> *data() noexcept {
+    return std::get<I>(columns_).data();
+  }
+  template <std::size_t I> const column_value_type<I> *data() const noexcept {
+    return std::get<I>(columns_).data();
+  }
+
+  // 追加一行；某一列构造抛异常时，已经追加的列会撤销
+  void push_back(const value_type &row) {
+    push_row(row, std::index_sequence_for<Ts...>{});
+  }
+  void push_back(value_type &&row) {
+    push_row(std::move(row), std::index_sequence_for<Ts...>{});
+  }
+
+  // 每个参数构造对应的一列
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Ts))
+  reference emplace_back(Args &&...args) {
+    push_row(std::forward_as_tuple(std::forward<Args>(args)...),
+             std::index_sequence_for<Ts...>{});
+    return back();
+  }
+
+  void pop_back() {
+    if (!empty()) {
+      std::apply([](auto &...cols) { (cols.pop_back(), ...); }, columns_);
+    }
+  }
+
+  void clear() noexcept {
+    std::apply([](auto &...cols) { (cols.clear(), ...); }, columns_);
+  }
+
+  void reserve(size_type new_cap) {
+    std::apply([new_cap](auto &...cols) { (cols.reserve(new_cap), ...); },
+               columns_);
+  }
+
+  // 新增的行每一列都值初始化
+  void resize(size_type count) {
+    std::apply([count](auto &...cols) { (cols.resize(count), ...); },
+               columns_);
+  }
+
+  void shrink_to_fit() {
+    std::apply([](auto &...cols) { (cols.shrink_to_fit(), ...); }, columns_);
+  }
+
+  size_type size() const noexcept { return std::get<0>(columns_).size(); }
+  size_type capacity() const noexcept {
+    return std::apply(
+        [](const auto &...cols) { return std::min({cols.capacity()...}); },
+        columns_);
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  // 打印所有行，每行形如 (a, b, c)
+  void printElements() const {
+    for (size_type i = 0; i < size(); ++i) {
+      std::cout << "(";
+      std::apply(
+          [](const auto &first, const auto &...rest) {
+            std::cout << first;
+            ((std::cout << ", " << rest), ...);
+          },
+          (*this)[i]);
+      std::cout << ") ";
+    }
+    std::cout << std::endl;
+  }
+
+  // 迭代器 interface
+  iterator begin() noexcept { return iterator(this, 0); }
+  iterator end() noexcept { return iterator(this, size()); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+private:
+  std::tuple<column_storage<Ts>...> columns_;
+
+  template <typename Tuple, std::size_t... Is>
+  void push_row(Tuple &&row, std::index_sequence<Is...>) {
+    std::size_t done = 0;
+    try {
+      ((std::get<Is>(columns_).emplace_back(
+            std::get<Is>(std::forward<Tuple>(row))),
+        ++done),
+       ...);
+    } catch (...) {
+      ((Is < done ? std::get<Is>(columns_).pop_back() : void()), ...);
+      throw;
+    }
+  }
+};
+
+} // namespace my_stl
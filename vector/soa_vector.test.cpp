@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "simd_algorithms.hpp"
+#include "soa_vector.hpp"
+
+namespace {
+// 拷贝到第 N 次时抛异常
+struct Fragile {
+  static inline int copies_left = 0;
+  int value = 0;
+
+  Fragile() = default;
+  explicit Fragile(int value) : value(value) {}
+  Fragile(const Fragile &other) : value(other.value) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  Fragile &operator=(const Fragile &) = default;
+};
+} // namespace
+
+TEST_CASE("my_stl::soa_vector stores one contiguous column per field") {
+  my_stl::soa_vector<float, std::int32_t, std::string> v;
+  REQUIRE(v.empty());
+
+  v.push_back({1.5f, 10, "a"});
+  v.push_back(std::make_tuple(2.5f, 20, std::string("b")));
+  auto [x, id, name] = v.emplace_back(3.5f, 30, "c");
+  REQUIRE(x == 3.5f);
+  REQUIRE(id == 30);
+  REQUIRE(name == "c");
+
+  REQUIRE(v.size() == 3);
+  REQUIRE(std::get<1>(v[1]) == 20);
+  REQUIRE(std::get<2>(v.back()) == "c");
+
+  std::span<float> xs = v.column<0>();
+  REQUIRE(xs.size() == 3);
+  REQUIRE(xs[2] == 3.5f);
+  REQUIRE(&xs[1] == &std::get<0>(v[1]));
+  REQUIRE(reinterpret_cast<std::uintptr_t>(v.data<1>()) % 64 == 0);
+  REQUIRE(my_stl::simd::accumulate(xs.data(), xs.data() + xs.size(), 0.0f) ==
+          7.5f);
+
+  // 代理引用写穿到各列
+  v[0] = std::make_tuple(9.0f, 90, std::string("z"));
+  std::get<1>(v[2]) = 31;
+  REQUIRE(v.column<0>()[0] == 9.0f);
+  REQUIRE(v.column<2>()[0] == "z");
+  REQUIRE(v.column<1>()[2] == 31);
+
+  REQUIRE_THROWS_AS(v.at(3), std::out_of_range);
+}
+
+TEST_CASE("my_stl::soa_vector row iteration and resizing") {
+  my_stl::soa_vector<int, double> v{{1, 0.5}, {2, 1.5}, {3, 2.5}};
+
+  int id_sum = 0;
+  double weight_sum = 0;
+  for (auto [id, weight] : v) {
+    id_sum += id;
+    weight_sum += weight;
+  }
+  REQUIRE(id_sum == 6);
+  REQUIRE(weight_sum == 4.5);
+
+  for (auto row : v) {
+    std::get<0>(row) *= 10;
+  }
+  const auto &cv = v;
+  REQUIRE(std::get<0>(*(cv.begin() + 2)) == 30);
+  REQUIRE(cv.end() - cv.begin() == 3);
+  REQUIRE(v.column<0>()[1] == 20);
+
+  v.resize(5);
+  REQUIRE(v.size() == 5);
+  REQUIRE(std::get<0>(v[4]) == 0);
+  REQUIRE(std::get<1>(v[4]) == 0.0);
+  v.pop_back();
+  REQUIRE(v.size() == 4);
+  v.reserve(100);
+  REQUIRE(v.capacity() >= 100);
+  v.clear();
+  REQUIRE(v.empty());
+}
+
+TEST_CASE("my_stl::soa_vector keeps columns the same length on exceptions") {
+  Fragile::copies_left = 100;
+  my_stl::soa_vector<int, Fragile> v;
+  v.push_back({1, Fragile(1)});
+  const std::tuple<int, Fragile> row{2, Fragile(2)};
+
+  Fragile::copies_left = 0;
+  REQUIRE_THROWS_AS(v.push_back(row), std::runtime_error);
+  REQUIRE(v.size() == 1);
+  REQUIRE(v.column<0>().size() == 1);
+  REQUIRE(v.column<1>().size() == 1);
+}
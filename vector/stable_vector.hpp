@@ -0,0 +1,415 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace my_stl {
+
+// 分段存储的 vector：元素放在一串容量按 2 倍递增的块里
+// （FirstBlock, 2 * FirstBlock, 4 * FirstBlock, ...），块指针存在固定大小的目录中。
+// 扩容只是再分配一个新块，已有元素从不移动，所以元素的指针和引用
+// 在 push_back / reserve 之后依然有效，也不会出现新旧两份缓冲区同时存在的峰值。
+// operator[] 用 bit_width 算出块号和块内偏移，仍是 O(1)。
+template <typename T, std::size_t FirstBlock = 16> class stable_vector {
+  static_assert(std::has_single_bit(FirstBlock),
+                "FirstBlock must be a power of two");
+
+  static constexpr std::size_t first_shift = std::countr_zero(FirstBlock);
+  // 目录大小：块数再多容量就超出 size_t 了
+  static constexpr std::size_t max_blocks =
+      std::numeric_limits<std::size_t>::digits - first_shift - 1;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+  stable_vector() noexcept = default;
+
+  // 委托构造完成后对象已经成立，中途抛异常会由析构函数清理
+  stable_vector(std::initializer_list<T> ilist) : stable_vector() {
+    reserve(ilist.size());
+    for (const auto &elem : ilist) {
+      emplace_back(elem);
+    }
+  }
+
+  ~stable_vector() {
+    clear();
+    release_blocks(0);
+  }
+
+  // 拷贝构造函数
+  stable_vector(const stable_vector &other) : stable_vector() {
+    reserve(other.size_);
+    for (const T &elem : other) {
+      emplace_back(elem);
+    }
+  }
+
+  // 拷贝赋值操作符
+  stable_vector &operator=(const stable_vector &other) {
+    if (this == &other)
+      return *this;
+
+    stable_vector tmp(other);
+    swap(tmp);
+    return *this;
+  }
+
+  // Move constructor：整个目录接管过来，元素地址不变
+  stable_vector(stable_vector &&other) noexcept { swap(other); }
+
+  // Move assignment
+  stable_vector &operator=(stable_vector &&other) noexcept {
+    if (this == &other)
+      return *this;
+
+    stable_vector tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+
+  class iterator {
+    friend class stable_vector;
+    friend class const_iterator;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = T *;
+    using reference = T &;
+
+    iterator() noexcept : owner_(nullptr), index_(0) {}
+    reference operator*() const { return (*owner_)[index_]; }
+    pointer operator->() const { return std::addressof((*owner_)[index_]); }
+
+    iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    iterator operator--(int) {
+      iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    iterator operator+(difference_type n) const {
+      return iterator(owner_, index_ + n);
+    }
+    iterator operator-(difference_type n) const {
+      return iterator(owner_, index_ - n);
+    }
+    reference operator[](difference_type n) const { return *(*this + n); }
+    difference_type operator-(const iterator &rhs) const {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(rhs.index_);
+    }
+
+    friend iterator operator+(difference_type n, const iterator &it) {
+      return it + n;
+    }
+
+    auto operator<=>(const iterator &) const = default;
+
+  private:
+    stable_vector *owner_;
+    size_type index_;
+
+    iterator(stable_vector *owner, size_type index)
+        : owner_(owner), index_(index) {}
+  };
+  class const_iterator {
+    friend class stable_vector;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator() noexcept : owner_(nullptr), index_(0) {}
+    const_iterator(const iterator &it) : owner_(it.owner_), index_(it.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    pointer operator->() const { return std::addressof((*owner_)[index_]); }
+    const_iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    const_iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    const_iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    const_iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    const_iterator operator+(difference_type n) const {
+      return const_iterator(owner_, index_ + n);
+    }
+    const_iterator operator-(difference_type n) const {
+      return const_iterator(owner_, index_ - n);
+    }
+    reference operator[](difference_type n) const { return *(*this + n); }
+    difference_type operator-(const const_iterator &rhs) const {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(rhs.index_);
+    }
+
+    friend const_iterator operator+(difference_type n,
+                                    const const_iterator &it) {
+      return it + n;
+    }
+
+    auto operator<=>(const const_iterator &) const = default;
+
+  private:
+    const stable_vector *owner_;
+    size_type index_;
+
+    const_iterator(const stable_vector *owner, size_type index)
+        : owner_(owner), index_(index) {}
+  };
+
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  reference operator[](size_type pos) noexcept {
+    auto [block, offset] = locate(pos);
+    return blocks_[block][offset];
+  }
+  const_reference operator[](size_type pos) const noexcept {
+    auto [block, offset] = locate(pos);
+    return blocks_[block][offset];
+  }
+
+  // at
+  reference at(size_type pos) {
+    if (pos >= size_)
+      throw std::out_of_range("stable_vector::at out of range");
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= size_)
+      throw std::out_of_range("stable_vector::at out of range");
+    return (*this)[pos];
+  }
+
+  reference front() {
+    if (empty())
+      throw std::out_of_range("stable_vector::front on empty vector");
+    return (*this)[0];
+  }
+  const_reference front() const {
+    if (empty())
+      throw std::out_of_range("stable_vector::front on empty vector");
+    return (*this)[0];
+  }
+
+  reference back() {
+    if (empty())
+      throw std::out_of_range("stable_vector::back on empty vector");
+    return (*this)[size_ - 1];
+  }
+  const_reference back() const {
+    if (empty())
+      throw std::out_of_range("stable_vector::back on empty vector");
+    return (*this)[size_ - 1];
+  }
+
+  // 添加元素到末尾；已有元素不会移动
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  // 在末尾原地构造元素，返回的引用在之后的 push_back 中一直有效
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (size_ == capacity()) {
+      add_block();
+    }
+    auto [block, offset] = locate(size_);
+    T *slot = std::construct_at(blocks_[block] + offset,
+                                std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  // 删除末尾的元素
+  void pop_back() {
+    if (size_ > 0) {
+      --size_;
+      std::destroy_at(std::addressof((*this)[size_]));
+    }
+  }
+
+  // 析构所有元素，保留已分配的块
+  void clear() noexcept {
+    while (size_ > 0) {
+      pop_back();
+    }
+  }
+
+  // 逐块分配直到容量不小于 new_cap，不移动任何元素
+  void reserve(size_type new_cap) {
+    while (capacity() < new_cap) {
+      add_block();
+    }
+  }
+
+  // 释放完全没有元素的块
+  void shrink_to_fit() noexcept {
+    size_type needed = 0;
+    while (block_capacity(needed) < size_) {
+      ++needed;
+    }
+    release_blocks(needed);
+  }
+
+  // 改变元素个数，新增的元素值初始化或拷贝自 value
+  void resize(size_type count) {
+    while (size_ > count) {
+      pop_back();
+    }
+    reserve(count);
+    while (size_ < count) {
+      emplace_back();
+    }
+  }
+  void resize(size_type count, const T &value) {
+    while (size_ > count) {
+      pop_back();
+    }
+    reserve(count);
+    while (size_ < count) {
+      emplace_back(value);
+    }
+  }
+
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return block_capacity(block_count_); }
+  bool empty() const noexcept { return size_ == 0; }
+
+  // 已分配的块数
+  size_type block_count() const noexcept { return block_count_; }
+
+  // 打印数组中的元素
+  void printElements() const {
+    for (size_type i = 0; i < size_; ++i) {
+      std::cout << (*this)[i] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  // 迭代器 interface
+  iterator begin() noexcept { return iterator(this, 0); }
+  iterator end() noexcept { return iterator(this, size_); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(cend());
+  }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(cbegin());
+  }
+
+  void swap(stable_vector &other) noexcept {
+    std::swap(blocks_, other.blocks_);
+    std::swap(block_count_, other.block_count_);
+    std::swap(size_, other.size_);
+  }
+
+private:
+  T *blocks_[max_blocks] = {}; // 第 k 块有 FirstBlock << k 个元素
+  size_type block_count_ = 0;
+  size_type size_ = 0;
+
+  static constexpr size_type block_size(size_type k) noexcept {
+    return FirstBlock << k;
+  }
+
+  // 前 k 块的总容量：FirstBlock * (2^k - 1)
+  static constexpr size_type block_capacity(size_type k) noexcept {
+    return ((size_type{1} << k) - 1) << first_shift;
+  }
+
+  // 下标 -> (块号, 块内偏移)
+  static constexpr std::pair<size_type, size_type>
+  locate(size_type pos) noexcept {
+    size_type k = std::bit_width((pos >> first_shift) + 1) - 1;
+    return {k, pos - block_capacity(k)};
+  }
+
+  void add_block() {
+    if (block_count_ == max_blocks) {
+      throw std::length_error("stable_vector is full");
+    }
+    blocks_[block_count_] =
+        std::allocator<T>{}.allocate(block_size(block_count_));
+    ++block_count_;
+  }
+
+  // 释放第 first 块及之后的块，调用方保证里面没有元素
+  void release_blocks(size_type first) noexcept {
+    while (block_count_ > first) {
+      --block_count_;
+      std::allocator<T>{}.deallocate(blocks_[block_count_],
+                                     block_size(block_count_));
+      blocks_[block_count_] = nullptr;
+    }
+  }
+};
+
+} // namespace my_stl
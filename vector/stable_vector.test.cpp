@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "stable_vector.hpp"
+
+namespace {
+struct Counted {
+  static inline int alive = 0;
+  int value;
+
+  explicit Counted(int value = 0) : value(value) { ++alive; }
+  Counted(const Counted &other) : value(other.value) { ++alive; }
+  ~Counted() { --alive; }
+};
+} // namespace
+
+TEST_CASE("my_stl::stable_vector iterators are random access") {
+  STATIC_REQUIRE(
+      std::random_access_iterator<my_stl::stable_vector<int>::iterator>);
+  STATIC_REQUIRE(
+      std::random_access_iterator<my_stl::stable_vector<int>::const_iterator>);
+}
+
+TEST_CASE("my_stl::stable_vector never moves existing elements") {
+  my_stl::stable_vector<int, 4> v;
+  v.push_back(0);
+  int *first = &v[0];
+  int &ref = v.emplace_back(1);
+
+  for (int i = 2; i < 10000; ++i) {
+    v.push_back(i);
+  }
+  REQUIRE(first == &v[0]);
+  REQUIRE(&ref == &v[1]);
+  REQUIRE(v.size() == 10000);
+  for (int i = 0; i < 10000; ++i) {
+    REQUIRE(v[i] == i);
+  }
+
+  // 块大小 4, 8, 16, ...：容量总是 4 * (2^k - 1)
+  REQUIRE(v.capacity() == 16380);
+  REQUIRE(v.block_count() == 12);
+
+  // 参数引用自身元素也没问题，扩容不会搬动它
+  while (v.size() < v.capacity()) {
+    v.push_back(0);
+  }
+  v.push_back(v[1]);
+  REQUIRE(v.back() == 1);
+}
+
+TEST_CASE("my_stl::stable_vector iterators, copy and move") {
+  my_stl::stable_vector<std::string, 2> v{"d", "a", "c", "b", "e"};
+  std::sort(v.begin(), v.end());
+  REQUIRE(v.front() == "a");
+  REQUIRE(v.back() == "e");
+  REQUIRE(*(v.begin() + 3) == "d");
+  REQUIRE(v.end() - v.begin() == 5);
+  REQUIRE(*v.crbegin() == "e");
+
+  my_stl::stable_vector<std::string, 2> copy(v);
+  copy[0] = "z";
+  REQUIRE(v[0] == "a");
+
+  const std::string *addr = &v[4];
+  my_stl::stable_vector<std::string, 2> moved(std::move(v));
+  REQUIRE(v.empty());
+  REQUIRE(&moved[4] == addr);
+
+  v = copy;
+  REQUIRE(v.size() == 5);
+  REQUIRE(v[0] == "z");
+
+  REQUIRE_THROWS_AS(v.at(5), std::out_of_range);
+  v.clear();
+  REQUIRE_THROWS_AS(v.front(), std::out_of_range);
+}
+
+TEST_CASE("my_stl::stable_vector resize, pop_back and shrink_to_fit") {
+  Counted::alive = 0;
+  {
+    my_stl::stable_vector<Counted, 8> v;
+    v.resize(100, Counted(7));
+    REQUIRE(Counted::alive == 100);
+    REQUIRE(v[99].value == 7);
+
+    v.resize(10);
+    REQUIRE(Counted::alive == 10);
+    v.pop_back();
+    REQUIRE(v.size() == 9);
+    REQUIRE(Counted::alive == 9);
+
+    REQUIRE(v.capacity() == 120);
+    Counted *kept = &v[8];
+    v.shrink_to_fit();
+    REQUIRE(v.capacity() == 24);
+    REQUIRE(&v[8] == kept);
+
+    v.reserve(1000);
+    REQUIRE(v.capacity() >= 1000);
+    REQUIRE(&v[8] == kept);
+  }
+  REQUIRE(Counted::alive == 0);
+}
@@ -1,40 +1,450 @@
+#pragma once
+
 #include <algorithm>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <new>
+#include <ranges>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "growth_policy.hpp"
+#include "snapshot.hpp"
+
 namespace my_stl {
 
-template <typename T> class vector {
+// 定制点：T 能否用 memcpy/memmove 整块搬走（搬完后源对象不再析构）。
+// 默认只对 trivially copyable 的类型成立；像只持有一个堆指针的句柄类，
+// 可以特化为 std::true_type 来走字节搬运的快速路径。
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+namespace detail {
+
+// 在未初始化的 dest 上构造 [first, first + n) 的副本，源对象原样保留：
+// move 不抛异常就 move，否则退回 copy，中途失败时源数组不受影响
+template <typename T>
+constexpr void uninitialized_move_if_noexcept(T *first, std::size_t n,
+                                              T *dest) {
+  if constexpr (is_trivially_relocatable_v<T>) {
+    // 常量求值里不能 memcpy，退回逐个构造
+    if (!std::is_constant_evaluated()) {
+      if (n != 0)
+        std::memcpy(static_cast<void *>(dest), first, n * sizeof(T));
+      return;
+    }
+  }
+  std::size_t i = 0;
+  try {
+    for (; i < n; ++i) {
+      std::construct_at(dest + i, std::move_if_noexcept(first[i]));
+    }
+  } catch (...) {
+    std::destroy(dest, dest + i);
+    throw;
+  }
+}
+
+// 结束已经被搬走的源对象；按字节搬走的对象不再析构
+template <typename T>
+constexpr void destroy_relocated(T *first, std::size_t n) noexcept {
+  if (!is_trivially_relocatable_v<T> || std::is_constant_evaluated()) {
+    std::destroy(first, first + n);
+  }
+}
+
+// 把 [first, first + n) 搬到未初始化的 dest 上，保证扩容失败时原数组不变
+template <typename T>
+constexpr void relocate(T *first, std::size_t n, T *dest) {
+  uninitialized_move_if_noexcept(first, n, dest);
+  destroy_relocated(first, n);
+}
+
+// [pos, end) 整体后移一位，再把 value 放进 pos；end 处必须是未初始化存储
+template <typename T>
+constexpr void insert_shift(T *pos, T *end, T &&value) {
+  if (is_trivially_relocatable_v<T> && !std::is_constant_evaluated()) {
+    // 整段尾部一次 memmove 后移，pos 处变成未初始化的空位
+    std::memmove(static_cast<void *>(pos + 1), pos,
+                 static_cast<std::size_t>(end - pos) * sizeof(T));
+    std::construct_at(pos, std::move(value));
+  } else {
+    std::construct_at(end, std::move(end[-1]));
+    std::move_backward(pos, end - 1, end);
+    *pos = std::move(value);
+  }
+}
+
+// 删除 [first, last)，把 [last, end) 前移补上
+template <typename T>
+constexpr void erase_shift(T *first, T *last, T *end) {
+  if (is_trivially_relocatable_v<T> && !std::is_constant_evaluated()) {
+    // 先析构被删除的元素，再把尾部整段 memmove 到空出来的位置
+    std::destroy(first, last);
+    std::memmove(static_cast<void *>(first), last,
+                 static_cast<std::size_t>(end - last) * sizeof(T));
+  } else {
+    T *new_end = std::move(last, end, first);
+    // 尾部被移走的元素要真正析构，释放它们持有的资源
+    std::destroy(new_end, end);
+  }
+}
+
+// std::uninitialized_copy_n 在 C++20 里还不是 constexpr，常量求值时逐个构造
+template <typename It, typename T>
+constexpr T *uninitialized_copy_n(It first, std::size_t n, T *dest) {
+  if (!std::is_constant_evaluated()) {
+    return std::uninitialized_copy_n(first, n, dest);
+  }
+  std::size_t i = 0;
+  try {
+    for (; i < n; ++i, ++first) {
+      std::construct_at(dest + i, *first);
+    }
+  } catch (...) {
+    std::destroy(dest, dest + i);
+    throw;
+  }
+  return dest + n;
+}
+
+} // namespace detail
+
+// 透明大页的大小（x86-64 / AArch64 上的 2 MiB）
+inline constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+// Alignment：data() 的对齐保证，至少为 alignof(T)。
+// HugePageThreshold：非 0 时，不小于这个字节数的分配改用 mmap，
+//                    并用 madvise(MADV_HUGEPAGE) 请求透明大页（仅 Linux）。
+//
+// 构造、增删、下标和迭代器都是 constexpr 的，可以在编译期生成查找表再拷进
+// std::array。常量求值时只用 std::allocator 分配，Alignment、大页和
+// malloc 尾部空闲都不起作用；printElements、save/load 只能在运行时用。
+template <typename T, typename Growth = grow_2x,
+          std::size_t Alignment = alignof(T),
+          std::size_t HugePageThreshold = 0>
+class vector {
+  static_assert(Alignment >= alignof(T) &&
+                    (Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two no smaller than alignof(T)");
+  static_assert(HugePageThreshold == 0 || Alignment <= 4096,
+                "mmap only guarantees page alignment");
+
 private:
-  std::unique_ptr<T[]> elements; // 指向动态数组的指针
-  size_t capacity_;              // 数组的容量
+  T *elements;      // 指向未初始化存储的指针，只有 [0, size_) 上有活对象
+  size_t capacity_; // 数组的容量
   size_t size_;
 
-  // 扩展数组容量
-  void reserve(size_t new_cap) {
-    if (new_cap <= capacity_)
+  static constexpr bool over_aligned =
+      Alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  static constexpr size_t round_up(size_t bytes, size_t to) noexcept {
+    return (bytes + to - 1) / to * to;
+  }
+
+  // 这么大的分配是否走 mmap 大页
+  static constexpr bool uses_huge_pages(size_t n) noexcept {
+#if defined(__linux__)
+    return HugePageThreshold != 0 && n * sizeof(T) >= HugePageThreshold;
+#else
+    return false;
+#endif
+  }
+
+  // 只分配至少 n 个元素的原始内存，不构造任何元素；
+  // 大页映射或增长策略收回分配器空闲时，n 会被改成实际能放下的元素个数
+  // 常量求值时只能用 std::allocator，对齐和大页都无从谈起
+  static constexpr T *allocate(size_t &n) {
+    if (n == 0)
+      return nullptr;
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+      throw std::bad_alloc();
+    if (std::is_constant_evaluated())
+      return std::allocator<T>{}.allocate(n);
+
+#if defined(__linux__)
+    if (uses_huge_pages(n)) {
+      size_t bytes = round_up(n * sizeof(T), huge_page_size);
+      void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED)
+        throw std::bad_alloc();
+      ::madvise(p, bytes, MADV_HUGEPAGE); // 只是建议，失败也不影响正确性
+      n = bytes / sizeof(T);
+      return static_cast<T *>(p);
+    }
+#endif
+
+    if constexpr (Growth::claims_allocator_slack) {
+      void *p = over_aligned
+                    ? std::aligned_alloc(Alignment,
+                                         round_up(n * sizeof(T), Alignment))
+                    : std::malloc(n * sizeof(T));
+      if (p == nullptr)
+        throw std::bad_alloc();
+#if defined(__GLIBC__)
+      size_t usable = malloc_usable_size(p) / sizeof(T);
+      if constexpr (HugePageThreshold != 0) {
+        // 收回空闲后不能跨过大页阈值，否则释放时会被误认为是 mmap 出来的
+        usable = std::min(usable, (HugePageThreshold - 1) / sizeof(T));
+      }
+      n = std::max(n, usable);
+#endif
+      return static_cast<T *>(p);
+    } else if constexpr (over_aligned) {
+      return static_cast<T *>(
+          ::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    } else {
+      return std::allocator<T>{}.allocate(n);
+    }
+  }
+  static constexpr void deallocate(T *p, size_t n) noexcept {
+    if (p == nullptr)
+      return;
+    if (std::is_constant_evaluated()) {
+      std::allocator<T>{}.deallocate(p, n);
       return;
+    }
+#if defined(__linux__)
+    if (uses_huge_pages(n)) {
+      ::munmap(p, round_up(n * sizeof(T), huge_page_size));
+      return;
+    }
+#endif
+    if constexpr (Growth::claims_allocator_slack) {
+      std::free(p);
+    } else if constexpr (over_aligned) {
+      ::operator delete(p, std::align_val_t{Alignment});
+    } else {
+      std::allocator<T>{}.deallocate(p, n);
+    }
+  }
+
+  // 析构所有元素并归还内存
+  constexpr void release() noexcept {
+    std::destroy(elements, elements + size_);
+    deallocate(elements, capacity_);
+  }
 
-    auto new_buf = std::make_unique<T[]>(new_cap);
+  // 放下 required 个元素所需的新容量，由增长策略决定
+  constexpr size_t next_capacity(size_t required) const noexcept {
+    return Growth::next_capacity(capacity_, required);
+  }
 
-    for (std::size_t i = 0; i < size_; ++i) {
-      new_buf[i] = elements[i];
+  // 满了再 emplace_back：先在新缓冲区里构造新元素再搬旧元素，
+  // 这样参数引用的是自身元素时也不会悬空
+  template <typename... Args>
+  constexpr T &grow_and_emplace_back(Args &&...args) {
+    size_t new_cap = next_capacity(size_ + 1);
+    T *new_buf = allocate(new_cap);
+    try {
+      std::construct_at(new_buf + size_, std::forward<Args>(args)...);
+      try {
+        detail::relocate(elements, size_, new_buf);
+      } catch (...) {
+        std::destroy_at(new_buf + size_);
+        throw;
+      }
+    } catch (...) {
+      deallocate(new_buf, new_cap);
+      throw;
     }
 
-    elements = std::move(new_buf);
+    deallocate(elements, capacity_);
+    elements = new_buf;
     capacity_ = new_cap;
+    return elements[size_++];
   }
 
-  void swap(vector &other) noexcept {
+  // 同一个值重复 n 次的只读"迭代器"，让 count/value 版本复用区间逻辑
+  struct repeat_iterator {
+    const T *value;
+
+    constexpr const T &operator*() const noexcept { return *value; }
+    constexpr repeat_iterator &operator++() noexcept { return *this; }
+  };
+
+  // 在 index 处插入从 first 开始的 n 个元素：最多分配一次，尾部只移动一次。
+  // It 只需支持 * 和前置 ++；区间不能引用本数组内的元素
+  template <typename It>
+  constexpr void insert_n(size_t index, It first, size_t n) {
+    if (n == 0)
+      return;
+
+    if (n > capacity_ - size_) {
+      // 新元素先在新缓冲区里构造好，再把前后两段搬过去
+      size_t new_cap = next_capacity(size_ + n);
+      T *new_buf = allocate(new_cap);
+      size_t built = 0;
+      try {
+        for (; built < n; ++built, ++first) {
+          std::construct_at(new_buf + index + built, *first);
+        }
+        detail::uninitialized_move_if_noexcept(elements, index, new_buf);
+        try {
+          detail::uninitialized_move_if_noexcept(
+              elements + index, size_ - index, new_buf + index + n);
+        } catch (...) {
+          std::destroy(new_buf, new_buf + index);
+          throw;
+        }
+      } catch (...) {
+        std::destroy(new_buf + index, new_buf + index + built);
+        deallocate(new_buf, new_cap);
+        throw;
+      }
+
+      detail::destroy_relocated(elements, size_);
+      deallocate(elements, capacity_);
+      elements = new_buf;
+      capacity_ = new_cap;
+      size_ += n;
+      return;
+    }
+
+    T *pos = elements + index;
+    T *end = elements + size_;
+    size_t after = size_ - index;
+
+    if (is_trivially_relocatable_v<T> && !std::is_constant_evaluated()) {
+      // 尾部整段 memmove 让出 n 个空位，再在空位上构造新元素
+      std::memmove(static_cast<void *>(pos + n), pos, after * sizeof(T));
+      size_t built = 0;
+      try {
+        for (; built < n; ++built, ++first) {
+          std::construct_at(pos + built, *first);
+        }
+      } catch (...) {
+        std::destroy(pos, pos + built);
+        std::memmove(static_cast<void *>(pos), pos + n, after * sizeof(T));
+        throw;
+      }
+      size_ += n;
+    } else if (after > n) {
+      // 尾部最后 n 个搬到未初始化区，其余整体后移，空出的位置直接赋值
+      detail::uninitialized_copy_n(std::make_move_iterator(end - n), n, end);
+      size_ += n;
+      std::move_backward(pos, end - n, end);
+      for (size_t i = 0; i < n; ++i, ++first) {
+        pos[i] = *first;
+      }
+    } else {
+      // 新区间比尾部长：超出尾部的那部分直接构造在未初始化区
+      It mid = first;
+      for (size_t i = 0; i < after; ++i) {
+        ++mid;
+      }
+      size_t built = 0;
+      try {
+        for (; built < n - after; ++built, ++mid) {
+          std::construct_at(end + built, *mid);
+        }
+        detail::uninitialized_copy_n(std::make_move_iterator(pos), after,
+                                     pos + n);
+      } catch (...) {
+        std::destroy(end, end + built);
+        throw;
+      }
+      size_ += n;
+      for (size_t i = 0; i < after; ++i, ++first) {
+        pos[i] = *first;
+      }
+    }
+  }
+
+  // 用从 first 开始的 n 个元素替换全部内容，容量不够时只分配一次
+  template <typename It> constexpr void assign_n(It first, size_t n) {
+    if (n > capacity_) {
+      size_t new_cap = n;
+      T *new_buf = allocate(new_cap);
+      size_t built = 0;
+      try {
+        for (; built < n; ++built, ++first) {
+          std::construct_at(new_buf + built, *first);
+        }
+      } catch (...) {
+        std::destroy(new_buf, new_buf + built);
+        deallocate(new_buf, new_cap);
+        throw;
+      }
+
+      release();
+      elements = new_buf;
+      capacity_ = new_cap;
+      size_ = n;
+      return;
+    }
+
+    size_t common = std::min(size_, n);
+    for (size_t i = 0; i < common; ++i, ++first) {
+      elements[i] = *first;
+    }
+    if (n < size_) {
+      std::destroy(elements + n, elements + size_);
+      size_ = n;
+    }
+    for (; size_ < n; ++size_, ++first) {
+      std::construct_at(elements + size_, *first);
+    }
+  }
+
+  // resize 的公共部分：缩小时析构尾部，扩大时用 construct 构造新元素
+  template <typename Construct>
+  constexpr void resize_with(size_t count, Construct construct) {
+    if (count <= size_) {
+      std::destroy(elements + count, elements + size_);
+      size_ = count;
+      return;
+    }
+
+    if (count > capacity_) {
+      reserve(next_capacity(count));
+    }
+    size_t old_size = size_;
+    try {
+      for (; size_ < count; ++size_) {
+        construct(elements + size_);
+      }
+    } catch (...) {
+      std::destroy(elements + old_size, elements + size_);
+      size_ = old_size;
+      throw;
+    }
+  }
+
+  constexpr void swap(vector &other) noexcept {
     std::swap(elements, other.elements);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
   }
 
+  template <typename Source> void load_snapshot_from(Source &source) {
+    vector tmp;
+    detail::load_snapshot<T>(source, [&tmp](size_t count) {
+      tmp.resize_for_overwrite(count);
+      return tmp.elements;
+    });
+    swap(tmp);
+  }
+
 public:
   using value_type = T;
   using size_type = std::size_t;
@@ -44,31 +454,40 @@ public:
   using const_pointer = const T *;
   // 构造函数
   // default user provied constructor
-  vector() : elements(nullptr), capacity_(0), size_(0) {};
-
-  vector(std::initializer_list<T> ilist)
-      : elements(std::make_unique<T[]>(ilist.size())), size_(ilist.size()),
-        capacity_(ilist.size()) {
-    std::size_t i = 0;
-    for (const auto &elem : ilist) {
-      elements[i++] = elem;
+  constexpr vector() : elements(nullptr), capacity_(0), size_(0) {};
+
+  constexpr vector(std::initializer_list<T> ilist)
+      : elements(nullptr), capacity_(ilist.size()), size_(0) {
+    elements = allocate(capacity_);
+    try {
+      for (const auto &elem : ilist) {
+        std::construct_at(elements + size_, elem);
+        ++size_;
+      }
+    } catch (...) {
+      release();
+      throw;
     }
   };
 
   // 析构函数
-  ~vector() = default;
+  constexpr ~vector() { release(); }
 
   // 拷贝构造函数
-  vector(const vector &other) : size_(other.size_), capacity_(other.capacity_) {
-    if (capacity_ > 0) {
-      elements = std::make_unique<T[]>(capacity_);
-      std::copy(other.elements.get(), other.elements.get() + size_,
-                elements.get());
+  constexpr vector(const vector &other)
+      : elements(nullptr), capacity_(other.capacity_), size_(0) {
+    elements = allocate(capacity_);
+    try {
+      detail::uninitialized_copy_n(other.elements, other.size_, elements);
+    } catch (...) {
+      deallocate(elements, capacity_);
+      throw;
     }
+    size_ = other.size_;
   }
 
   // 拷贝赋值操作符
-  vector &operator=(const vector &other) {
+  constexpr vector &operator=(const vector &other) {
     if (this == &other)
       return *this;
 
@@ -78,92 +497,158 @@ public:
   }
 
   // Move constructor
-  vector(vector &&other) noexcept
-      : elements(std::exchange(other.elements, std::unique_ptr<T[]>{})),
-        size_(std::exchange(other.size_, 0)),
-        capacity_(std::exchange(other.capacity_, 0)) {}
+  constexpr vector(vector &&other) noexcept
+      : elements(std::exchange(other.elements, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)) {}
 
   // Move assignment
-  vector &operator=(vector &&other) {
+  constexpr vector &operator=(vector &&other) noexcept {
     if (this == &other)
       return *this;
 
-    elements.reset();
-    elements = std::exchange(other.elements, std::unique_ptr<T[]>{});
+    release();
+    elements = std::exchange(other.elements, nullptr);
     size_ = std::exchange(other.size_, 0);
     capacity_ = std::exchange(other.capacity_, 0);
     return *this;
   }
-  T &operator[](std::size_t pos) { return elements[pos]; }
-  const T &operator[](std::size_t pos) const { return elements[pos]; }
+  constexpr T &operator[](std::size_t pos) { return elements[pos]; }
+  constexpr const T &operator[](std::size_t pos) const { return elements[pos]; }
 
   // member function
 
   // 删除数组末尾的元素
-  void pop_back() {
+  constexpr void pop_back() {
     if (size_ > 0) {
       --size_;
+      std::destroy_at(elements + size_);
     }
   };
 
   // 在指定位置插入元素
-  void insert(size_t index, const T &value) {
+  constexpr void insert(size_t index, const T &value) {
     if (index > size_) {
       throw std::out_of_range("Index out of range");
     }
-    if (size_ == capacity_) {
-      reserve(capacity_ == 0 ? 1 : capacity_ * 2);
-    }
-    for (size_t i = size_; i > index; --i) {
-      elements[i] = elements[i - 1];
+    emplace(cbegin() + static_cast<std::ptrdiff_t>(index), value);
+  };
+  constexpr void insert(size_t index, T &&value) {
+    if (index > size_) {
+      throw std::out_of_range("Index out of range");
     }
-    elements[index] = value;
-    ++size_;
+    emplace(cbegin() + static_cast<std::ptrdiff_t>(index), std::move(value));
   };
-  // 清空数组
-  void clear() { size_ = 0; }
+  // 清空数组，析构所有元素但保留容量
+  constexpr void clear() noexcept {
+    std::destroy(elements, elements + size_);
+    size_ = 0;
+  }
 
   // 添加元素到数组末尾
-  void push_back(const T &value) {
+  constexpr void push_back(const T &value) { emplace_back(value); }
+  constexpr void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  // 在数组末尾原地构造元素
+  template <typename... Args>
+  constexpr reference emplace_back(Args &&...args) {
     if (size_ == capacity_) {
       // 如果数组已满，扩展容量
-      reserve(capacity_ == 0 ? 1 : 2 * capacity_);
+      return grow_and_emplace_back(std::forward<Args>(args)...);
     }
-    elements[size_++] = value;
+    std::construct_at(elements + size_, std::forward<Args>(args)...);
+    return elements[size_++];
   }
 
   // 获取数组中元素的个数
-  size_t size() const { return size_; }
+  constexpr size_t size() const { return size_; }
 
   // 获取数组的容量
-  size_t capacity() const { return capacity_; }
+  constexpr size_t capacity() const { return capacity_; }
+
+  // 预留至少 new_cap 个元素的空间，批量写入前调用可以避免多次扩容
+  constexpr void reserve(size_t new_cap) {
+    if (new_cap <= capacity_)
+      return;
+
+    T *new_buf = allocate(new_cap);
+    try {
+      detail::relocate(elements, size_, new_buf);
+    } catch (...) {
+      deallocate(new_buf, new_cap);
+      throw;
+    }
+
+    deallocate(elements, capacity_);
+    elements = new_buf;
+    capacity_ = new_cap;
+  }
 
-  bool empty() const noexcept { return size_ == 0; }
+  // 把多余的容量还给系统
+  constexpr void shrink_to_fit() {
+    if (capacity_ == size_)
+      return;
+
+    size_t new_cap = size_;
+    T *new_buf = allocate(new_cap);
+    try {
+      detail::relocate(elements, size_, new_buf);
+    } catch (...) {
+      deallocate(new_buf, new_cap);
+      throw;
+    }
 
-  reference front() {
+    deallocate(elements, capacity_);
+    elements = new_buf;
+    capacity_ = new_cap;
+  }
+
+  // 改变元素个数：多出来的元素值初始化（int 为 0）或拷贝自 value
+  constexpr void resize(size_type count) {
+    resize_with(count, [](T *p) { std::construct_at(p); });
+  }
+  constexpr void resize(size_type count, const T &value) {
+    T tmp(value); // value 可能引用本数组内的元素
+    resize_with(count, [&tmp](T *p) { std::construct_at(p, tmp); });
+  }
+
+  // 和 resize 一样，但新元素只做默认初始化：对 char、int 这类平凡类型不清零，
+  // 适合马上要被 read() 之类整块覆盖的缓冲区
+  void resize_for_overwrite(size_type count) {
+    resize_with(count, [](T *p) { ::new (static_cast<void *>(p)) T; });
+  }
+
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr reference front() {
     if (empty())
       throw std::out_of_range("vector::front on empty vector");
     return elements[0];
   }
-  const_reference front() const {
+  constexpr const_reference front() const {
     if (empty())
       throw std::out_of_range("vector::front on empty vector");
     return elements[0];
   }
 
-  reference back() {
+  constexpr reference back() {
     if (empty())
       throw std::out_of_range("vector::back on empty vector");
     return elements[size_ - 1];
   }
-  const_reference back() const {
+  constexpr const_reference back() const {
     if (empty())
       throw std::out_of_range("vector::back on empty vector");
     return elements[size_ - 1];
   }
 
-  pointer data() noexcept { return elements.get(); }
-  const_pointer data() const noexcept { return elements.get(); }
+  // 数据至少按 Alignment 对齐，编译器可以据此生成对齐的向量化访存
+  constexpr pointer data() noexcept {
+    return std::assume_aligned<Alignment>(elements);
+  }
+  constexpr const_pointer data() const noexcept {
+    return std::assume_aligned<Alignment>(elements);
+  }
 
   // 打印数组中的元素
   void printElements() const {
@@ -173,13 +658,38 @@ public:
     std::cout << std::endl;
   }
 
+  // 二进制快照（格式见 snapshot.hpp）：header 之后整块写出 data()
+  void save(std::ostream &out) const
+    requires snapshottable<T>
+  {
+    detail::save_snapshot<T>(out, elements, size_, nullptr, 0);
+  }
+  void save(int fd) const
+    requires snapshottable<T>
+  {
+    detail::save_snapshot<T>(fd, elements, size_, nullptr, 0);
+  }
+
+  // 从快照恢复：一次性分配好缓冲区，元素字节直接读进去；
+  // 出错时抛异常，原有内容不变
+  void load(std::istream &in)
+    requires snapshottable<T>
+  {
+    load_snapshot_from(in);
+  }
+  void load(int fd)
+    requires snapshottable<T>
+  {
+    load_snapshot_from(fd);
+  }
+
   // at
-  T &at(std::size_t pos) {
+  constexpr T &at(std::size_t pos) {
     if (pos >= size_)
       throw std::out_of_range("SmartContainer::at out of range");
     return elements[pos];
   };
-  const T &at(std::size_t pos) const {
+  constexpr const T &at(std::size_t pos) const {
     if (pos >= size_)
       throw std::out_of_range("SmartContainer::at out of range");
     return elements[pos];
@@ -197,45 +707,59 @@ public:
     using pointer = value_type *;
     using reference = value_type &;
 
-    iterator() noexcept : ptr_(nullptr) {}
-    explicit iterator(pointer p) noexcept : ptr_(p) {}
+    constexpr iterator() noexcept : ptr_(nullptr) {}
+    constexpr explicit iterator(pointer p) noexcept : ptr_(p) {}
 
-    reference operator*() const noexcept { return *ptr_; }
-    pointer operator->() const noexcept { return ptr_; }
+    constexpr reference operator*() const noexcept { return *ptr_; }
+    constexpr pointer operator->() const noexcept { return ptr_; }
 
-    iterator operator+(difference_type n) const noexcept {
+    constexpr iterator operator+(difference_type n) const noexcept {
       return iterator(ptr_ + n);
     }
-    iterator operator-(difference_type n) const noexcept {
+    constexpr iterator operator-(difference_type n) const noexcept {
       return iterator(ptr_ - n);
     }
+    constexpr iterator &operator+=(difference_type n) noexcept {
+      ptr_ += n;
+      return *this;
+    }
+    constexpr iterator &operator-=(difference_type n) noexcept {
+      ptr_ -= n;
+      return *this;
+    }
+    friend constexpr iterator operator+(difference_type n,
+                                       const iterator &it) noexcept {
+      return it + n;
+    }
 
-    friend difference_type operator-(const iterator &a,
+    friend constexpr difference_type operator-(const iterator &a,
                                      const iterator &b) noexcept {
       return a.ptr_ - b.ptr_;
     }
 
-    iterator &operator++() noexcept {
+    constexpr iterator &operator++() noexcept {
       ++ptr_;
       return *this;
     }
-    iterator operator++(int) noexcept {
+    constexpr iterator operator++(int) noexcept {
       iterator tmp(*this);
       ++(*this);
       return tmp;
     }
 
-    iterator &operator--() noexcept {
+    constexpr iterator &operator--() noexcept {
       --ptr_;
       return *this;
     }
-    iterator operator--(int) noexcept {
+    constexpr iterator operator--(int) noexcept {
       iterator tmp(*this);
       --(*this);
       return tmp;
     }
 
-    reference operator[](difference_type n) const noexcept { return ptr_[n]; }
+    constexpr reference operator[](difference_type n) const noexcept {
+      return ptr_[n];
+    }
 
     // friend bool operator==(const iterator &a, const iterator &b) {}
     // friend bool operator!=(const iterator &a, const iterator &b) {}
@@ -259,44 +783,60 @@ public:
     using pointer = const value_type *;
     using reference = const value_type &;
 
-    const_iterator() noexcept : ptr_(nullptr) {}
-    explicit const_iterator(pointer p) noexcept : ptr_(p) {}
-    const_iterator(const iterator &other) noexcept : ptr_(other.ptr_) {}
+    constexpr const_iterator() noexcept : ptr_(nullptr) {}
+    constexpr explicit const_iterator(pointer p) noexcept : ptr_(p) {}
+    constexpr const_iterator(const iterator &other) noexcept
+        : ptr_(other.ptr_) {}
 
-    reference operator*() const noexcept { return *ptr_; }
-    pointer operator->() const noexcept { return ptr_; }
+    constexpr reference operator*() const noexcept { return *ptr_; }
+    constexpr pointer operator->() const noexcept { return ptr_; }
 
-    const_iterator &operator++() noexcept {
+    constexpr const_iterator &operator++() noexcept {
       ++ptr_;
       return *this;
     }
-    const_iterator operator++(int) noexcept {
+    constexpr const_iterator operator++(int) noexcept {
       const_iterator tmp(*this);
       ++(*this);
       return tmp;
     }
-    const_iterator &operator--() noexcept {
+    constexpr const_iterator &operator--() noexcept {
       --ptr_;
       return *this;
     }
-    const_iterator operator--(int) noexcept {
+    constexpr const_iterator operator--(int) noexcept {
       const_iterator tmp(*this);
       --(*this);
       return tmp;
     }
 
-    const_iterator operator+(difference_type n) const noexcept {
+    constexpr const_iterator operator+(difference_type n) const noexcept {
       return const_iterator(ptr_ + n);
     }
-    const_iterator operator-(difference_type n) const noexcept {
+    constexpr const_iterator operator-(difference_type n) const noexcept {
       return const_iterator(ptr_ - n);
     }
+    constexpr const_iterator &operator+=(difference_type n) noexcept {
+      ptr_ += n;
+      return *this;
+    }
+    constexpr const_iterator &operator-=(difference_type n) noexcept {
+      ptr_ -= n;
+      return *this;
+    }
+    friend constexpr const_iterator operator+(difference_type n,
+                                    const const_iterator &it) noexcept {
+      return it + n;
+    }
 
-    difference_type operator-(const const_iterator &other) const noexcept {
+    constexpr difference_type
+    operator-(const const_iterator &other) const noexcept {
       return ptr_ - other.ptr_;
     }
 
-    reference operator[](difference_type n) const noexcept { return ptr_[n]; }
+    constexpr reference operator[](difference_type n) const noexcept {
+      return ptr_[n];
+    }
 
     auto operator<=>(const const_iterator &) const = default;
 
@@ -307,30 +847,117 @@ public:
   // 迭代器 interface
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-  iterator begin() noexcept { return iterator(data()); };
-  iterator end() noexcept {
+  constexpr iterator begin() noexcept { return iterator(data()); };
+  constexpr iterator end() noexcept {
     pointer p = data();
     return iterator(size_ == 0 ? p : p + size_);
   };
 
-  const_iterator begin() const noexcept { return const_iterator(data()); }
-  const_iterator end() const noexcept {
+  constexpr const_iterator begin() const noexcept {
+    return const_iterator(data());
+  }
+  constexpr const_iterator end() const noexcept {
     const_pointer p = data();
     return const_iterator(size_ == 0 ? p : p + size_);
   }
 
-  const_iterator cbegin() const noexcept { return const_iterator(data()); }
-  const_iterator cend() const noexcept { return end(); }
+  constexpr const_iterator cbegin() const noexcept {
+    return const_iterator(data());
+  }
+  constexpr const_iterator cend() const noexcept { return end(); }
 
-  const_reverse_iterator crbegin() const noexcept {
+  constexpr const_reverse_iterator crbegin() const noexcept {
     return const_reverse_iterator(end());
   }
-  const_reverse_iterator crend() const noexcept {
+  constexpr const_reverse_iterator crend() const noexcept {
     return const_reverse_iterator(begin());
   }
 
-  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
-  iterator erase(const_iterator first, const_iterator last) {
+  // 在 pos 处原地构造元素，尾部整体向后移动一位
+  template <typename... Args>
+  constexpr iterator emplace(const_iterator pos, Args &&...args) {
+    size_type index = pos - cbegin();
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+      return begin() + static_cast<std::ptrdiff_t>(index);
+    }
+
+    // 参数可能引用数组内的元素，扩容和移动尾部之前先构造出来
+    T tmp(std::forward<Args>(args)...);
+    if (size_ == capacity_) {
+      reserve(next_capacity(size_ + 1));
+    }
+    detail::insert_shift(elements + index, elements + size_, std::move(tmp));
+    ++size_;
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
+
+  // 在 pos 处插入 [first, last)，最多扩容一次，尾部只移动一次；
+  // 区间不能引用本数组内的元素
+  template <std::input_iterator InputIt>
+  constexpr iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    size_type index = pos - cbegin();
+    if constexpr (std::forward_iterator<InputIt>) {
+      insert_n(index, first,
+               static_cast<size_type>(std::distance(first, last)));
+    } else {
+      // 单遍迭代器拿不到长度，先收集起来再整体插入
+      vector tmp;
+      for (; first != last; ++first) {
+        tmp.emplace_back(*first);
+      }
+      insert_n(index, std::make_move_iterator(tmp.data()), tmp.size());
+    }
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
+  constexpr iterator insert(const_iterator pos,
+                           std::initializer_list<T> ilist) {
+    return insert(pos, ilist.begin(), ilist.end());
+  }
+  // 在 pos 处插入 count 个 value
+  constexpr iterator insert(const_iterator pos, size_type count,
+                           const T &value) {
+    size_type index = pos - cbegin();
+    T tmp(value); // value 可能引用本数组内的元素
+    insert_n(index, repeat_iterator{&tmp}, count);
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
+
+  // 把整个区间追加到末尾
+  template <std::ranges::input_range R>
+  constexpr void append_range(R &&rg) {
+    if constexpr (std::ranges::forward_range<R>) {
+      insert_n(size_, std::ranges::begin(rg),
+               static_cast<size_type>(std::ranges::distance(rg)));
+    } else {
+      for (auto &&elem : rg) {
+        emplace_back(std::forward<decltype(elem)>(elem));
+      }
+    }
+  }
+
+  // 替换全部内容
+  constexpr void assign(size_type count, const T &value) {
+    T tmp(value); // value 可能引用本数组内的元素
+    assign_n(repeat_iterator{&tmp}, count);
+  }
+  template <std::input_iterator InputIt>
+  constexpr void assign(InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>) {
+      assign_n(first, static_cast<size_type>(std::distance(first, last)));
+    } else {
+      clear();
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    }
+  }
+  constexpr void assign(std::initializer_list<T> ilist) {
+    assign_n(ilist.begin(), ilist.size());
+  }
+
+  constexpr iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  constexpr iterator erase(const_iterator first, const_iterator last) {
     size_type first_index = first - cbegin();
     size_type last_index = last - cbegin();
     size_type count = last_index - first_index;
@@ -339,12 +966,20 @@ public:
       return begin() + static_cast<std::ptrdiff_t>(first_index);
     }
 
-    for (size_type i = first_index; i + count < size_; ++i) {
-      elements[i] = std::move(elements[i + count]);
-    }
+    detail::erase_shift(elements + first_index, elements + last_index,
+                        elements + size_);
 
     size_ -= count;
     return begin() + static_cast<std::ptrdiff_t>(first_index);
   }
 };
+
+// 给 SIMD 内核用：数据按 64 字节（一条 cache line）对齐
+template <typename T> using aligned_vector = vector<T, grow_2x, 64>;
+
+// 不小于 2 MiB 的缓冲区改用透明大页，减少 TLB miss
+template <typename T>
+using huge_page_vector =
+    vector<T, grow_2x, std::max<std::size_t>(alignof(T), 64), huge_page_size>;
+
 } // namespace my_stl
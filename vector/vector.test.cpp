@@ -1,7 +1,104 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "vector.hpp"
 
+namespace {
+struct NoDefault {
+  int value;
+
+  explicit NoDefault(int value) : value(value) {}
+};
+
+// 统计当前存活的对象个数
+struct Counted {
+  static inline int alive = 0;
+  int value;
+
+  explicit Counted(int value) : value(value) { ++alive; }
+  Counted(const Counted &other) : value(other.value) { ++alive; }
+  Counted &operator=(const Counted &) = default;
+  ~Counted() { --alive; }
+};
+
+// 只持有一个堆指针，按字节搬走是安全的
+struct Handle {
+  std::unique_ptr<int> ptr;
+
+  explicit Handle(int value) : ptr(std::make_unique<int>(value)) {}
+};
+} // namespace
+
+template <> struct my_stl::is_trivially_relocatable<Handle> : std::true_type {};
+
+namespace {
+// 编译期生成 CRC-32 表，再拷进 std::array
+constexpr std::array<std::uint32_t, 256> make_crc_table() {
+  my_stl::vector<std::uint32_t> table;
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t c = i;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1) != 0 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    table.push_back(c);
+  }
+  std::array<std::uint32_t, 256> out{};
+  std::copy(table.begin(), table.end(), out.begin());
+  return out;
+}
+
+constexpr auto crc_table = make_crc_table();
+static_assert(crc_table[1] == 0x77073096u);
+static_assert(crc_table[255] == 0x2D02EF8Du);
+
+// 常量求值里走的是逐个构造的分支，插入、删除、拷贝都要正确
+constexpr bool constexpr_edits_work() {
+  my_stl::vector<int> v{1, 2, 3, 4, 5};
+  v.erase(v.cbegin() + 1);
+  v.erase(v.cbegin(), v.cbegin() + 2);
+  v.insert(0, 0);
+  v.insert(v.cbegin() + 1, {7, 8});
+  v.insert(v.cend(), 2, 9);
+  my_stl::vector<int> copy = v;
+  copy.pop_back();
+  copy.reserve(100);
+  copy.resize(7, 6);
+  const int expected[] = {0, 7, 8, 4, 5, 9, 6};
+  return v.size() == 7 && v.back() == 9 &&
+         std::equal(copy.begin(), copy.end(), expected, expected + 7);
+}
+static_assert(constexpr_edits_work());
+
+constexpr bool constexpr_strings_work() {
+  my_stl::vector<std::string> v;
+  v.push_back("routing");
+  v.emplace_back(3, 'x');
+  v.emplace(v.cbegin(), "parser");
+  v.erase(v.cbegin() + 1);
+  return v.size() == 2 && v[0] == "parser" && v.at(1) == "xxx";
+}
+static_assert(constexpr_strings_work());
+} // namespace
+
 TEST_CASE("my_stl::vector basic push and size") {
   my_stl::vector<int> v;
   REQUIRE(v.size() == 0);
@@ -322,3 +419,549 @@ TEST_CASE("my_stl::vector const_iterator comparison") {
   REQUIRE(it1 == it2);
   REQUIRE_FALSE(it1 != it2);
 }
+
+
+TEST_CASE("my_stl::vector stores non-default-constructible types") {
+  my_stl::vector<NoDefault> v;
+  v.push_back(NoDefault(1));
+  v.push_back(NoDefault(2));
+  v.push_back(NoDefault(3));
+  v.insert(1, NoDefault(9));
+
+  REQUIRE(v.size() == 4);
+  REQUIRE(v.capacity() == 4);
+  REQUIRE(v[0].value == 1);
+  REQUIRE(v[1].value == 9);
+  REQUIRE(v[2].value == 2);
+  REQUIRE(v[3].value == 3);
+}
+
+TEST_CASE("my_stl::vector only constructs live elements") {
+  REQUIRE(Counted::alive == 0);
+  {
+    my_stl::vector<Counted> v;
+    for (int i = 0; i < 5; ++i) {
+      v.push_back(Counted(i));
+    }
+    REQUIRE(v.capacity() == 8);
+    REQUIRE(Counted::alive == 5);
+
+    v.pop_back();
+    REQUIRE(Counted::alive == 4);
+
+    v.erase(v.begin(), v.begin() + 2);
+    REQUIRE(Counted::alive == 2);
+    REQUIRE(v[0].value == 2);
+    REQUIRE(v[1].value == 3);
+
+    my_stl::vector<Counted> copy(v);
+    REQUIRE(Counted::alive == 4);
+
+    v.clear();
+    REQUIRE(Counted::alive == 2);
+  }
+  REQUIRE(Counted::alive == 0);
+}
+
+TEST_CASE("my_stl::vector push_back of own element survives growth") {
+  my_stl::vector<std::string> v{"a", "b"};
+  REQUIRE(v.size() == v.capacity());
+
+  v.push_back(v[0]);
+  v.insert(0, v[2]);
+
+  REQUIRE(v.size() == 4);
+  REQUIRE(v[0] == "a");
+  REQUIRE(v[1] == "a");
+  REQUIRE(v[2] == "b");
+  REQUIRE(v[3] == "a");
+}
+
+TEST_CASE("my_stl::vector push_back rvalue moves move-only types") {
+  my_stl::vector<std::unique_ptr<int>> v;
+  auto p = std::make_unique<int>(1);
+
+  v.push_back(std::move(p));
+  v.push_back(std::make_unique<int>(2));
+  v.push_back(std::make_unique<int>(3));
+
+  REQUIRE(p == nullptr);
+  REQUIRE(v.size() == 3);
+  REQUIRE(*v[0] == 1);
+  REQUIRE(*v[1] == 2);
+  REQUIRE(*v[2] == 3);
+}
+
+TEST_CASE("my_stl::vector emplace_back constructs in place") {
+  my_stl::vector<std::string> v;
+
+  auto &first = v.emplace_back(3, 'x');
+  REQUIRE(first == "xxx");
+
+  v.emplace_back("abc");
+  REQUIRE(v.size() == 2);
+  REQUIRE(v.back() == "abc");
+}
+
+TEST_CASE("my_stl::vector emplace shifts tail with moves") {
+  my_stl::vector<std::unique_ptr<int>> v;
+  v.emplace_back(new int(1));
+  v.emplace_back(new int(3));
+
+  auto it = v.emplace(v.cbegin() + 1, new int(2));
+  REQUIRE(**it == 2);
+
+  it = v.emplace(v.cbegin(), new int(0));
+  REQUIRE(it == v.begin());
+
+  it = v.emplace(v.cend(), new int(4));
+  REQUIRE(it == v.end() - 1);
+
+  REQUIRE(v.size() == 5);
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(*v[i] == i);
+  }
+}
+
+TEST_CASE("my_stl::vector insert rvalue moves into position") {
+  my_stl::vector<std::unique_ptr<int>> v;
+  v.push_back(std::make_unique<int>(2));
+
+  auto p = std::make_unique<int>(1);
+  v.insert(0, std::move(p));
+
+  REQUIRE(p == nullptr);
+  REQUIRE(*v[0] == 1);
+  REQUIRE(*v[1] == 2);
+  REQUIRE_THROWS_AS(v.insert(3, std::make_unique<int>(9)), std::out_of_range);
+}
+
+TEST_CASE("my_stl::vector relocation trait defaults to trivially copyable") {
+  STATIC_REQUIRE(my_stl::is_trivially_relocatable_v<int>);
+  STATIC_REQUIRE_FALSE(my_stl::is_trivially_relocatable_v<std::string>);
+  STATIC_REQUIRE(my_stl::is_trivially_relocatable_v<Handle>);
+}
+
+TEST_CASE("my_stl::vector bulk moves trivially copyable elements") {
+  my_stl::vector<int> v;
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(i);
+  }
+
+  v.insert(0, -1);
+  v.emplace(v.cbegin() + 5, 100);
+  v.erase(v.begin() + 1, v.begin() + 3);
+
+  int expected[] = {-1, 2, 3, 100, 4, 5, 6, 7, 8, 9};
+  REQUIRE(v.size() == 10);
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(v[i] == expected[i]);
+  }
+}
+
+TEST_CASE("my_stl::vector bulk moves opted-in relocatable elements") {
+  my_stl::vector<Handle> v;
+  for (int i = 0; i < 6; ++i) {
+    v.emplace_back(i);
+  }
+
+  v.emplace(v.cbegin() + 2, 42);
+  v.erase(v.begin(), v.begin() + 2);
+  v.erase(v.begin() + 3);
+
+  int expected[] = {42, 2, 3, 5};
+  REQUIRE(v.size() == 4);
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE(*v[i].ptr == expected[i]);
+  }
+}
+
+TEST_CASE("my_stl::vector reserve grows capacity once") {
+  my_stl::vector<std::string> v{"a"};
+  v.reserve(100);
+  REQUIRE(v.capacity() == 100);
+  REQUIRE(v.size() == 1);
+
+  const std::string *before = v.data();
+  for (int i = 0; i < 99; ++i) {
+    v.push_back("x");
+  }
+  REQUIRE(v.data() == before);
+
+  v.reserve(10);
+  REQUIRE(v.capacity() == 100);
+}
+
+TEST_CASE("my_stl::vector range insert in middle, front and end") {
+  for (std::size_t extra : {0, 1, 8}) {
+    my_stl::vector<std::string> v{"a", "b", "c", "d"};
+    v.reserve(v.size() + extra);
+
+    std::list<std::string> src{"x", "y"};
+    auto it = v.insert(v.cbegin() + 1, src.begin(), src.end());
+    REQUIRE(*it == "x");
+
+    std::list<std::string> many{"1", "2", "3", "4", "5"};
+    it = v.insert(v.cbegin() + 6, many.begin(), many.end());
+    REQUIRE(it == v.begin() + 6);
+    v.insert(v.cbegin(), {"<"});
+
+    const char *expected[] = {"<", "a", "x", "y", "b", "c", "d",
+                              "1", "2", "3", "4", "5"};
+    REQUIRE(v.size() == 12);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      REQUIRE(v[i] == expected[i]);
+    }
+  }
+}
+
+TEST_CASE("my_stl::vector range insert allocates at most once") {
+  my_stl::vector<int> v{1, 2, 3};
+  int src[] = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+
+  v.insert(v.cbegin() + 1, std::begin(src), std::end(src));
+  REQUIRE(v.size() == 13);
+  REQUIRE(v.capacity() == 13);
+  REQUIRE(v[0] == 1);
+  REQUIRE(v[1] == 10);
+  REQUIRE(v[10] == 19);
+  REQUIRE(v[11] == 2);
+  REQUIRE(v[12] == 3);
+}
+
+TEST_CASE("my_stl::vector insert from single-pass iterators") {
+  std::istringstream in("4 5 6");
+  my_stl::vector<int> v{1, 2, 3, 7};
+
+  v.insert(v.cbegin() + 3, std::istream_iterator<int>(in),
+           std::istream_iterator<int>());
+
+  REQUIRE(v.size() == 7);
+  for (int i = 0; i < 7; ++i) {
+    REQUIRE(v[i] == i + 1);
+  }
+}
+
+TEST_CASE("my_stl::vector insert count copies of value") {
+  my_stl::vector<std::string> v{"a", "b", "c"};
+
+  auto it = v.insert(v.cbegin() + 1, 2, v[2]);
+  REQUIRE(*it == "c");
+  v.insert(v.cbegin() + 1, 3, std::string("z"));
+  v.insert(v.cend(), 0, std::string("never"));
+
+  const char *expected[] = {"a", "z", "z", "z", "c", "c", "b", "c"};
+  REQUIRE(v.size() == 8);
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    REQUIRE(v[i] == expected[i]);
+  }
+}
+
+TEST_CASE("my_stl::vector append_range appends whole ranges") {
+  my_stl::vector<int> v{1};
+  std::list<int> src{2, 3, 4};
+
+  v.append_range(src);
+  REQUIRE(v.size() == 4);
+  REQUIRE(v.capacity() == 4);
+
+  v.append_range(std::vector<int>{5, 6});
+  REQUIRE(v.size() == 6);
+  for (int i = 0; i < 6; ++i) {
+    REQUIRE(v[i] == i + 1);
+  }
+}
+
+TEST_CASE("my_stl::vector assign replaces contents") {
+  REQUIRE(Counted::alive == 0);
+  {
+    my_stl::vector<Counted> v;
+    v.assign(5, Counted(7));
+    REQUIRE(v.size() == 5);
+    REQUIRE(v.capacity() == 5);
+    REQUIRE(Counted::alive == 5);
+
+    v.assign(2, v[0]);
+    REQUIRE(v.size() == 2);
+    REQUIRE(Counted::alive == 2);
+    REQUIRE(v[1].value == 7);
+  }
+  REQUIRE(Counted::alive == 0);
+
+  my_stl::vector<int> v{1, 2, 3};
+  std::list<int> src{9, 8, 7, 6};
+  v.assign(src.begin(), src.end());
+  REQUIRE(v.size() == 4);
+  REQUIRE(v[0] == 9);
+  REQUIRE(v[3] == 6);
+
+  v.assign({4, 5});
+  REQUIRE(v.size() == 2);
+  REQUIRE(v[0] == 4);
+  REQUIRE(v[1] == 5);
+}
+
+TEST_CASE("my_stl::vector resize value-initializes and destroys") {
+  my_stl::vector<int> v{1, 2};
+
+  v.resize(5);
+  REQUIRE(v.size() == 5);
+  REQUIRE(v[1] == 2);
+  REQUIRE(v[2] == 0);
+  REQUIRE(v[4] == 0);
+
+  v.resize(7, v[0]);
+  REQUIRE(v.size() == 7);
+  REQUIRE(v[6] == 1);
+
+  REQUIRE(Counted::alive == 0);
+  {
+    my_stl::vector<Counted> c;
+    c.resize(3, Counted(4));
+    REQUIRE(Counted::alive == 3);
+    c.resize(1, Counted(5));
+    REQUIRE(Counted::alive == 1);
+    REQUIRE(c[0].value == 4);
+  }
+  REQUIRE(Counted::alive == 0);
+}
+
+TEST_CASE("my_stl::vector resize_for_overwrite as a read buffer") {
+  std::istringstream in("hello, buffer");
+  my_stl::vector<char> buf;
+
+  buf.resize_for_overwrite(5);
+  REQUIRE(buf.size() == 5);
+  in.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+  REQUIRE(std::string(buf.data(), buf.size()) == "hello");
+
+  my_stl::vector<std::string> strings;
+  strings.resize_for_overwrite(2);
+  REQUIRE(strings[0].empty());
+  REQUIRE(strings[1].empty());
+}
+
+TEST_CASE("my_stl::vector shrink_to_fit releases spare capacity") {
+  my_stl::vector<std::string> v;
+  v.reserve(16);
+  v.push_back("a");
+  v.push_back("b");
+
+  v.shrink_to_fit();
+  REQUIRE(v.capacity() == 2);
+  REQUIRE(v[0] == "a");
+  REQUIRE(v[1] == "b");
+
+  v.clear();
+  v.shrink_to_fit();
+  REQUIRE(v.capacity() == 0);
+  REQUIRE(v.data() == nullptr);
+}
+
+TEST_CASE("my_stl::vector growth policies pick the next capacity") {
+  my_stl::vector<int, my_stl::grow_1_5x> half;
+  my_stl::vector<int, my_stl::grow_fixed<4>> fixed;
+  for (int i = 0; i < 10; ++i) {
+    half.push_back(i);
+    fixed.push_back(i);
+  }
+
+  // 1.5x: 1 -> 2 -> 4 -> 7 -> 11
+  REQUIRE(half.capacity() == 11);
+  // +4: 4 -> 8 -> 12
+  REQUIRE(fixed.capacity() == 12);
+
+  int src[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  fixed.insert(fixed.cend(), std::begin(src), std::end(src));
+  REQUIRE(fixed.capacity() == 26);
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(half[i] == i);
+    REQUIRE(fixed[i] == i);
+  }
+}
+
+TEST_CASE("my_stl::vector size-class growth claims allocator slack") {
+  my_stl::vector<char, my_stl::grow_size_class> v;
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(static_cast<char>('a' + i % 26));
+  }
+
+  REQUIRE(v.size() == 100);
+  REQUIRE(v.capacity() >= 100);
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(v[i] == static_cast<char>('a' + i % 26));
+  }
+
+  v.reserve(1000);
+  REQUIRE(v.capacity() >= 1000);
+  v.shrink_to_fit();
+  REQUIRE(v.capacity() >= 100);
+  REQUIRE(v.back() == static_cast<char>('a' + 99 % 26));
+}
+
+TEST_CASE("my_stl::vector over-aligned storage keeps its alignment") {
+  auto aligned_to = [](const void *p, std::uintptr_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+  };
+
+  my_stl::aligned_vector<float> v;
+  for (int i = 0; i < 1000; ++i) {
+    v.push_back(static_cast<float>(i));
+    REQUIRE(aligned_to(v.data(), 64));
+  }
+  v.insert(v.cbegin(), 3, -1.0f);
+  v.shrink_to_fit();
+  REQUIRE(aligned_to(v.data(), 64));
+  REQUIRE(v[0] == -1.0f);
+  REQUIRE(v[1002] == 999.0f);
+
+  my_stl::aligned_vector<float> copy(v);
+  REQUIRE(aligned_to(copy.data(), 64));
+  REQUIRE(copy.size() == 1003);
+
+  my_stl::vector<double, my_stl::grow_size_class, 128> slack;
+  slack.resize(100, 1.5);
+  REQUIRE(aligned_to(slack.data(), 128));
+  REQUIRE(slack.capacity() >= 100);
+}
+
+TEST_CASE("my_stl::vector large buffers switch to huge-page mappings") {
+  // 阈值调低到 4 KiB，让测试里的小数组也走 mmap 路径
+  my_stl::vector<int, my_stl::grow_2x, alignof(int), 4096> v;
+  for (int i = 0; i < 100000; ++i) {
+    v.push_back(i);
+  }
+
+  REQUIRE(v.size() == 100000);
+  for (int i = 0; i < 100000; i += 997) {
+    REQUIRE(v[i] == i);
+  }
+  v.erase(v.begin(), v.begin() + 99000);
+  v.shrink_to_fit();
+  REQUIRE(v.size() == 1000);
+  REQUIRE(v.front() == 99000);
+  REQUIRE(v.back() == 99999);
+
+  my_stl::huge_page_vector<char> buf;
+  buf.resize_for_overwrite(3 << 20);
+  REQUIRE(buf.capacity() >= (3u << 20));
+  buf[0] = 'a';
+  buf[buf.size() - 1] = 'z';
+  REQUIRE(buf.front() == 'a');
+  REQUIRE(buf.back() == 'z');
+}
+
+TEST_CASE("my_stl::vector snapshots round-trip through streams and fds") {
+  my_stl::vector<std::uint64_t> v;
+  for (std::uint64_t i = 0; i < 1001; ++i) {
+    v.push_back(i * i);
+  }
+
+  std::stringstream stream;
+  v.save(stream);
+  REQUIRE(stream.str().size() == 64 + 1001 * sizeof(std::uint64_t));
+
+  my_stl::vector<std::uint64_t> restored{7, 8};
+  restored.load(stream);
+  REQUIRE(restored.size() == 1001);
+  REQUIRE(restored[1000] == 1000000);
+
+  std::string path =
+      (std::filesystem::temp_directory_path() / "vector_snapshot.bin")
+          .string();
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  REQUIRE(fd >= 0);
+  v.save(fd);
+  ::close(fd);
+
+  my_stl::vector<std::uint64_t> from_fd;
+  fd = ::open(path.c_str(), O_RDONLY);
+  from_fd.load(fd);
+  ::close(fd);
+  REQUIRE(from_fd.size() == 1001);
+  REQUIRE(from_fd.back() == 1000000);
+
+  // 直接映射文件，不拷贝
+  my_stl::mapped_snapshot<std::uint64_t> mapped(path);
+  REQUIRE(mapped.size() == 1001);
+  REQUIRE(mapped[30] == 900);
+  REQUIRE(mapped.verify());
+  std::remove(path.c_str());
+}
+
+TEST_CASE("my_stl::vector load rejects bad snapshots and keeps contents") {
+  my_stl::vector<int> v{1, 2, 3};
+  std::stringstream good;
+  v.save(good);
+  std::string bytes = good.str();
+
+  my_stl::vector<int> target{9};
+
+  std::stringstream wrong_type;
+  my_stl::vector<double>{1.0}.save(wrong_type);
+  REQUIRE_THROWS_AS(target.load(wrong_type), std::runtime_error);
+
+  std::string corrupt = bytes;
+  corrupt.back() ^= 1;
+  std::stringstream corrupted(corrupt);
+  REQUIRE_THROWS_AS(target.load(corrupted), std::runtime_error);
+
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 2));
+  REQUIRE_THROWS_AS(target.load(truncated), std::runtime_error);
+
+  REQUIRE(target.size() == 1);
+  REQUIRE(target[0] == 9);
+}
+
+TEST_CASE("my_stl::vector load checks the header count before allocating") {
+  my_stl::vector<int> v{1, 2, 3};
+  std::stringstream good;
+  v.save(good);
+  const std::string bytes = good.str();
+
+  // header 里的 count 在第 24 字节
+  auto with_count = [&bytes](std::uint64_t count) {
+    std::string patched = bytes;
+    std::memcpy(patched.data() + 24, &count, sizeof(count));
+    return patched;
+  };
+  auto load_error = [](my_stl::vector<int> &target, std::istream &in) {
+    try {
+      target.load(in);
+    } catch (const std::runtime_error &e) {
+      return std::string(e.what());
+    }
+    return std::string();
+  };
+
+  my_stl::vector<int> target{9};
+  // 比剩下的字节多一个元素、大到会申请巨量内存、乘以 sizeof(int) 会溢出
+  for (std::uint64_t count : {std::uint64_t{4}, std::uint64_t{1} << 40,
+                              std::uint64_t{1} << 62}) {
+    std::stringstream in(with_count(count));
+    REQUIRE(load_error(target, in) == "snapshot: checksum mismatch");
+  }
+  REQUIRE(target.size() == 1);
+  REQUIRE(target[0] == 9);
+
+  std::string path =
+      (std::filesystem::temp_directory_path() / "vector_bad_count.bin")
+          .string();
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << with_count(std::uint64_t{1} << 40);
+  }
+  int fd = ::open(path.c_str(), O_RDONLY);
+  REQUIRE(fd >= 0);
+  REQUIRE_THROWS_AS(target.load(fd), std::runtime_error);
+  ::close(fd);
+  std::remove(path.c_str());
+  REQUIRE(target.size() == 1);
+}
+
+TEST_CASE("my_stl::vector builds lookup tables at compile time") {
+  // 同一个函数在运行时也要得到相同的结果
+  REQUIRE(make_crc_table() == crc_table);
+  REQUIRE(constexpr_edits_work());
+  REQUIRE(constexpr_strings_work());
+}